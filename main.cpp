@@ -1,9 +1,136 @@
 #include "mainwindow.h"
 #include <QApplication>
+#include <QDate>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QVector>
+#include <algorithm>
+
+// Temps minimal et médian d'une série de mesures, en millisecondes
+static QString resumer(QVector<double> durees)
+{
+    std::sort(durees.begin(), durees.end());
+    return "min " + QString::number(durees.first(), 'f', 1) + " ms, médiane "
+           + QString::number(durees[durees.size() / 2], 'f', 1) + " ms";
+}
+
+// --mesure-demarrage [N] : construit et affiche N fois la fenêtre principale
+// jusqu'à son premier rendu. La construction (widgets et polissage du
+// thème) et le premier rendu sont mesurés séparément. La fonction ne
+// dépend que du constructeur de MainWindow : recopiée dans le main.cpp
+// d'une version antérieure, elle donne la mesure « avant ».
+static int mesurerDemarrage(int iterations)
+{
+    QVector<double> constructions;
+    QVector<double> rendus;
+    QVector<double> totaux;
+    for (int i = 0; i < iterations; ++i) {
+        QElapsedTimer chrono;
+        chrono.start();
+        {
+            MainWindow w;
+            const qint64 construit = chrono.nsecsElapsed();
+            w.show();
+            QApplication::processEvents();
+            w.repaint();
+            const qint64 affiche = chrono.nsecsElapsed();
+            constructions.append(construit / 1e6);
+            rendus.append((affiche - construit) / 1e6);
+            totaux.append(affiche / 1e6);
+        }
+        QApplication::processEvents();
+    }
+
+    QTextStream out(stdout);
+    out << "Démarrage (" << iterations << " mesures)\n"
+        << "  construction  : " << resumer(constructions) << "\n"
+        << "  premier rendu : " << resumer(rendus) << "\n"
+        << "  total         : " << resumer(totaux) << "\n";
+    return 0;
+}
+
+// --mesure-chargement [N] : importe N commandes fournisseurs synthétiques,
+// d'abord une par une (une notification et un rafraîchissement des
+// statistiques par commande, comme la saisie au formulaire), puis en un seul
+// lot dans une fenêtre neuve. Dans les deux cas, la page fournisseurs est
+// affichée avant le chronomètre : table, filtre et statistiques sont
+// attachés et suivent l'import. Code de retour 1 si le lot dépasse
+// l'objectif d'une seconde.
+static int mesurerChargement(int commandes)
+{
+    const QDate aujourdhui = QDate::currentDate();
+    QVector<OrderRecord> records;
+    records.reserve(commandes);
+    for (int i = 0; i < commandes; ++i) {
+        OrderRecord record;
+        record.nom = QString("Fournisseur %1").arg(i % 500);
+        record.produit = QString("Produit %1").arg(i % 40);
+        record.dateCommande = aujourdhui.addDays(-(i % 365));
+        record.dateLivraison = record.dateCommande.addDays(7 + i % 10);
+        record.statut = record.dateLivraison <= aujourdhui ? "Livrée" : "En cours";
+        record.prixHT = 100.0 + i % 900;
+        record.prixTTC = record.prixHT * 1.19;
+        record.avance = record.prixTTC / 2;
+        record.resteAPayer = record.prixTTC - record.avance;
+        record.modePaiement = "Virement";
+        records.append(record);
+    }
+
+    double unParUn = 0.0;
+    {
+        MainWindow w;
+        w.show();
+        QMetaObject::invokeMethod(&w, "openGestionFournisseurs");
+        QApplication::processEvents();
+
+        QElapsedTimer chrono;
+        chrono.start();
+        for (const OrderRecord &record : std::as_const(records))
+            w.importerCommandesFournisseurs({record});
+        QApplication::processEvents();
+        unParUn = chrono.nsecsElapsed() / 1e6;
+    }
+
+    double enLot = 0.0;
+    {
+        MainWindow w;
+        w.show();
+        QMetaObject::invokeMethod(&w, "openGestionFournisseurs");
+        QApplication::processEvents();
+
+        QElapsedTimer chrono;
+        chrono.start();
+        w.importerCommandesFournisseurs(records);
+        QApplication::processEvents();
+        enLot = chrono.nsecsElapsed() / 1e6;
+    }
+
+    const bool atteint = enLot < 1000.0;
+    QTextStream out(stdout);
+    out << "Import de " << commandes << " commandes\n"
+        << "  une par une : " << QString::number(unParUn, 'f', 1) << " ms\n"
+        << "  en un lot   : " << QString::number(enLot, 'f', 1) << " ms ("
+        << QString::number(unParUn / qMax(enLot, 1e-3), 'f', 1) << " x)\n"
+        << "  objectif < 1 s : " << (atteint ? "atteint" : "non atteint") << "\n";
+    return atteint ? 0 : 1;
+}
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    const QStringList arguments = a.arguments();
+    const int mesure = arguments.indexOf("--mesure-demarrage");
+    if (mesure >= 0) {
+        const int iterations = mesure + 1 < arguments.size() ? qMax(1, arguments[mesure + 1].toInt()) : 10;
+        return mesurerDemarrage(iterations);
+    }
+    const int chargement = arguments.indexOf("--mesure-chargement");
+    if (chargement >= 0) {
+        const int commandes = chargement + 1 < arguments.size() ? qMax(1, arguments[chargement + 1].toInt()) : 100000;
+        return mesurerChargement(commandes);
+    }
+
     MainWindow w;
     w.show();
     return a.exec();
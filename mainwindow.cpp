@@ -16,6 +16,7 @@
 #include <QSpinBox>
 #include <QDateEdit>
 #include <QTableWidgetItem>
+#include <QItemSelectionModel>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QRegularExpressionValidator>
@@ -37,6 +38,17 @@
 #include <QMap>
 #include <QTimer>
 #include <QTime>
+#include <QDateTime>
+#include <QRunnable>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QDir>
+#include <QPicture>
+#include <QTextFrame>
+#include <QThread>
+#include <QFile>
+#include <QProgressBar>
+#include <QStatusBar>
 #include <cmath>
 #include <QSplitter>
 #include <QAbstractItemView>
@@ -46,6 +58,27 @@
 #include <QFont>
 #include <QFontMetrics>
 #include <QtMath>
+#include <QStyledItemDelegate>
+#include <QToolTip>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QScreen>
+#include <QWindow>
+#include <QSet>
+#include <QStyleFactory>
+#include <QStyleOption>
+#include <QAbstractSpinBox>
+#include <QTableView>
+#include <algorithm>
+#include <climits>
+#include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MAINWINDOW_HAS_SSE2
+#endif
 
 // =======================
 // PieChartWidget (implementation)
@@ -58,81 +91,2522 @@ PieChartWidget::PieChartWidget(QWidget *parent)
              << QColor(106, 138, 74)  << QColor(139, 195, 74)
              << QColor(33, 150, 243)  << QColor(255, 152, 0)
              << QColor(156, 39, 176)  << QColor(121, 85, 72);
+
+    m_legendFont = QFont("Arial", 10, QFont::Bold);
+    m_totalFont = QFont("Arial", 11, QFont::Bold);
+    setMouseTracking(true);
 }
 
 void PieChartWidget::setData(const QMap<QString, int> &data, int total)
 {
     m_data = data;
     m_total = total;
+    invalidateCache();
+}
+
+void PieChartWidget::setData(QMap<QString, int> &&data, int total)
+{
+    m_data = std::move(data);
+    m_total = total;
+    invalidateCache();
+}
+
+void PieChartWidget::invalidateCache()
+{
+    m_cache = QPixmap();
+    update();
+}
+
+void PieChartWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_cache = QPixmap();
+}
+
+void PieChartWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    const qreal dpr = devicePixelRatioF();
+    if (m_cache.isNull() || !qFuzzyCompare(m_cache.devicePixelRatio(), dpr)) {
+        layoutChart();
+
+        m_cache = QPixmap(size() * dpr);
+        m_cache.setDevicePixelRatio(dpr);
+        m_cache.fill(Qt::transparent);
+
+        QPainter cachePainter(&m_cache);
+        cachePainter.setRenderHint(QPainter::Antialiasing);
+        renderChart(cachePainter);
+    }
+
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_cache);
+}
+
+void PieChartWidget::layoutChart()
+{
+    m_slices.clear();
+    m_sliceEnds.clear();
+    m_autres.clear();
+    if (m_total == 0 || m_data.isEmpty())
+        return;
+
+    const int margin = 10;
+    const int legendWidth = 160;
+    const int legendItemHeight = 24;
+    const int chartSize = qMax(0, qMin(width() - legendWidth - margin * 3, height() - margin * 2 - 30));
+    m_pieRect = QRect(margin, margin, chartSize, chartSize);
+
+    // Parts décroissantes ; les petites parts et celles qui ne tiennent pas
+    // dans la légende sont regroupées dans « Autres »
+    QVector<QPair<QString, int>> entries;
+    entries.reserve(m_data.size());
+    for (auto it = m_data.constBegin(); it != m_data.constEnd(); ++it)
+        entries.append(qMakePair(it.key(), it.value()));
+    std::sort(entries.begin(), entries.end(), [](const QPair<QString, int> &a, const QPair<QString, int> &b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+
+    int visible = entries.size();
+    while (visible > 0 && entries[visible - 1].second * 100.0 / m_total < SeuilAutresPourcent)
+        --visible;
+    const int capacity = qMax(1, (height() - margin * 2) / legendItemHeight);
+    if (visible < entries.size() && visible + 1 > capacity)
+        visible = capacity - 1;
+    else if (visible == entries.size() && visible > capacity)
+        visible = capacity - 1;
+    // Regrouper une seule part n'apporte rien
+    if (visible == entries.size() - 1)
+        visible = entries.size();
+
+    int autresTotal = 0;
+    for (int i = visible; i < entries.size(); ++i) {
+        autresTotal += entries[i].second;
+        m_autres << entries[i].first;
+    }
+
+    const QFontMetrics legendMetrics(m_legendFont);
+    const int legendX = m_pieRect.right() + margin;
+    const int labelWidth = qMax(0, width() - legendX - 20 - margin);
+
+    double startAngle = 0.0;
+    auto addSlice = [&](const QString &label, int value, const QColor &color) {
+        Slice slice;
+        slice.label = label;
+        slice.value = value;
+        slice.startAngle = startAngle;
+        slice.spanAngle = value * 360.0 / m_total;
+        slice.color = color;
+        slice.legendRect = QRect(legendX, margin + m_slices.size() * legendItemHeight, width() - legendX, 15);
+        slice.legendText = legendMetrics.elidedText(
+            QString("%1 (%2%)").arg(label).arg(QString::number(value * 100.0 / m_total, 'f', 1)),
+            Qt::ElideRight, labelWidth);
+        startAngle += slice.spanAngle;
+        m_slices.append(slice);
+        m_sliceEnds.append(startAngle);
+    };
+
+    for (int i = 0; i < visible; ++i)
+        addSlice(entries[i].first, entries[i].second, m_colors[i % m_colors.size()]);
+    if (autresTotal > 0)
+        addSlice("Autres", autresTotal, QColor(160, 160, 160));
+}
+
+void PieChartWidget::renderChart(QPainter &painter) const
+{
+    if (m_slices.isEmpty()) {
+        painter.setPen(QColor(74, 106, 42));
+        painter.setFont(m_totalFont);
+        painter.drawText(rect(), Qt::AlignCenter, "Aucune production enregistrée.");
+        return;
+    }
+
+    painter.setFont(m_legendFont);
+    for (const Slice &slice : m_slices) {
+        painter.setBrush(slice.color);
+        painter.setPen(QPen(QColor(255, 255, 255), 2));
+        painter.drawPie(m_pieRect, static_cast<int>(slice.startAngle * 16), static_cast<int>(slice.spanAngle * 16));
+
+        QRect colorBox(slice.legendRect.left(), slice.legendRect.top(), 15, 15);
+        painter.setBrush(slice.color);
+        painter.setPen(QPen(QColor(200, 200, 200), 1));
+        painter.drawRect(colorBox);
+
+        painter.setPen(QColor(26, 48, 9));
+        painter.drawText(slice.legendRect.left() + 20, slice.legendRect.top() + 12, slice.legendText);
+    }
+
+    painter.setPen(QColor(74, 106, 42));
+    painter.setFont(m_totalFont);
+    QString totalText = QString("Total: %1 production%2").arg(m_total).arg(m_total > 1 ? "s" : "");
+    QFontMetrics fm(m_totalFont);
+    int textWidth = fm.horizontalAdvance(totalText);
+    int textY = m_pieRect.bottom() + 20;
+    if (textY < height() - 5) {
+        painter.drawText((width() - textWidth) / 2, textY, totalText);
+    }
+}
+
+int PieChartWidget::sliceAt(const QPoint &pos) const
+{
+    // Légende : lignes à hauteur fixe
+    for (int i = 0; i < m_slices.size(); ++i) {
+        if (m_slices[i].legendRect.contains(pos))
+            return i;
+    }
+
+    // Camembert : angle depuis 3 h dans le sens trigonométrique, puis
+    // recherche dichotomique dans les angles de fin cumulés
+    const QPointF center = QRectF(m_pieRect).center();
+    const double dx = pos.x() - center.x();
+    const double dy = center.y() - pos.y();
+    const double radius = m_pieRect.width() / 2.0;
+    if (m_slices.isEmpty() || dx * dx + dy * dy > radius * radius)
+        return -1;
+
+    double angle = qRadiansToDegrees(std::atan2(dy, dx));
+    if (angle < 0)
+        angle += 360.0;
+    auto it = std::upper_bound(m_sliceEnds.constBegin(), m_sliceEnds.constEnd(), angle);
+    if (it == m_sliceEnds.constEnd())
+        return m_slices.size() - 1;
+    return int(it - m_sliceEnds.constBegin());
+}
+
+void PieChartWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    QWidget::mouseMoveEvent(event);
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    const QPoint pos = event->position().toPoint();
+    const QPoint globalPos = event->globalPosition().toPoint();
+#else
+    const QPoint pos = event->pos();
+    const QPoint globalPos = event->globalPos();
+#endif
+
+    const int index = sliceAt(pos);
+    if (index < 0) {
+        QToolTip::hideText();
+        return;
+    }
+
+    const Slice &slice = m_slices[index];
+    QString text = QString("%1 : %2 (%3%)")
+                       .arg(slice.label)
+                       .arg(slice.value)
+                       .arg(QString::number(slice.value * 100.0 / m_total, 'f', 1));
+    if (slice.label == "Autres" && !m_autres.isEmpty()) {
+        const int shown = qMin(10, int(m_autres.size()));
+        text += "\n" + m_autres.mid(0, shown).join(", ");
+        if (m_autres.size() > shown)
+            text += QString(", … (+%1)").arg(m_autres.size() - shown);
+    }
+    QToolTip::showText(globalPos, text, this);
+}
+
+// =======================
+// LineChartWidget (implementation)
+// =======================
+LineChartWidget::LineChartWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setCursor(Qt::OpenHandCursor);
+}
+
+void LineChartWidget::setData(const QStringList &labels, const QVector<Series> &series)
+{
+    m_labels = labels;
+    m_series = series;
+    m_cache.clear();
+    m_debut = 0.0;
+    m_fin = qMax(0, pointCount() - 1);
+    update();
+}
+
+// Texte affiché tant qu'aucune série n'a de point
+void LineChartWidget::setEmptyText(const QString &texte)
+{
+    m_emptyText = texte;
+    update();
+}
+
+// Largest-Triangle-Three-Buckets : garde le premier et le dernier point, puis
+// dans chaque seau le point qui forme le plus grand triangle avec le point
+// retenu précédemment et la moyenne du seau suivant. Les pics sont conservés.
+QVector<QPointF> LineChartWidget::lttb(const QVector<double> &valeurs, int seuil)
+{
+    const int n = valeurs.size();
+    QVector<QPointF> result;
+    if (seuil >= n || seuil < 3) {
+        result.reserve(n);
+        for (int i = 0; i < n; ++i)
+            result.append(QPointF(i, valeurs[i]));
+        return result;
+    }
+
+    result.reserve(seuil);
+    const double pas = double(n - 2) / (seuil - 2);
+    int retenu = 0;
+    result.append(QPointF(0, valeurs[0]));
+
+    for (int seau = 0; seau < seuil - 2; ++seau) {
+        const int suivantDebut = int(std::floor((seau + 1) * pas)) + 1;
+        const int suivantFin = qMin(int(std::floor((seau + 2) * pas)) + 1, n);
+        double moyenneX = 0.0;
+        double moyenneY = 0.0;
+        for (int j = suivantDebut; j < suivantFin; ++j) {
+            moyenneX += j;
+            moyenneY += valeurs[j];
+        }
+        const int taille = qMax(1, suivantFin - suivantDebut);
+        moyenneX /= taille;
+        moyenneY /= taille;
+
+        const int debut = int(std::floor(seau * pas)) + 1;
+        const int fin = int(std::floor((seau + 1) * pas)) + 1;
+        const double ax = retenu;
+        const double ay = valeurs[retenu];
+        double aireMax = -1.0;
+        int choisi = debut;
+        for (int j = debut; j < fin; ++j) {
+            const double aire = std::abs((ax - moyenneX) * (valeurs[j] - ay) - (ax - j) * (moyenneY - ay));
+            if (aire > aireMax) {
+                aireMax = aire;
+                choisi = j;
+            }
+        }
+        result.append(QPointF(choisi, valeurs[choisi]));
+        retenu = choisi;
+    }
+
+    result.append(QPointF(n - 1, valeurs[n - 1]));
+    return result;
+}
+
+QRect LineChartWidget::plotRect() const
+{
+    const int marginLeft = 60;
+    const int marginRight = 10;
+    const int marginTop = 24;
+    const int marginBottom = 24;
+    return QRect(marginLeft, marginTop, width() - marginLeft - marginRight, height() - marginTop - marginBottom);
+}
+
+int LineChartWidget::pointCount() const
+{
+    return m_labels.size();
+}
+
+void LineChartWidget::clampWindow()
+{
+    const double dernier = qMax(0, pointCount() - 1);
+    const double minimum = qMin(dernier, 10.0);
+    double etendue = qBound(minimum, m_fin - m_debut, dernier);
+
+    m_debut = qBound(0.0, m_debut, dernier - etendue);
+    m_fin = m_debut + etendue;
+}
+
+// Niveau 0 : toute la série tient dans la largeur du tracé. Chaque niveau
+// double la résolution ; le cache d'un niveau sert tous les déplacements.
+// Au-delà du premier niveau qui garde tous les points, les zooms plus
+// profonds partagent cette même entrée.
+const QVector<QVector<QPointF>> &LineChartWidget::decimated(int niveau)
+{
+    const int largeur = plotRect().width();
+    if (largeur != m_cacheWidth) {
+        m_cache.clear();
+        m_cacheWidth = largeur;
+    }
+
+    const qint64 total = pointCount();
+    int plafond = 0;
+    while (plafond < 30 && (qint64(qMax(1, largeur)) << plafond) < total)
+        ++plafond;
+    niveau = qMin(niveau, plafond);
+
+    auto it = m_cache.find(niveau);
+    if (it == m_cache.end()) {
+        const qint64 seuil = qint64(largeur) << niveau;
+        QVector<QVector<QPointF>> reduites;
+        reduites.reserve(m_series.size());
+        for (const Series &serie : m_series)
+            reduites.append(lttb(serie.valeurs, int(qMin<qint64>(seuil, serie.valeurs.size()))));
+        it = m_cache.insert(niveau, reduites);
+    }
+    return it.value();
+}
+
+void LineChartWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    if (m_labels.isEmpty()) {
+        painter.setPen(QColor(74, 106, 42));
+        painter.setFont(QFont("Arial", 11, QFont::Bold));
+        painter.drawText(rect(), Qt::AlignCenter, m_emptyText);
+        return;
+    }
+
+    const QRect plot = plotRect();
+    if (plot.width() <= 0 || plot.height() <= 0)
+        return;
+
+    const int count = pointCount();
+    const double etendue = m_fin - m_debut;
+    // Plus petit niveau dont la résolution couvre la fenêtre visible
+    // à raison d'un point par pixel : niveau = ceil(log2((n - 1) / etendue))
+    int niveau = 0;
+    if (etendue > 0.0 && count > 1)
+        niveau = qBound(0, int(std::ceil(std::log2((count - 1) / etendue))), 30);
+    const QVector<QVector<QPointF>> &reduites = decimated(niveau);
+
+    // Portion visible de chaque série réduite, plus un point de chaque côté
+    // pour que la courbe entre et sorte du cadre
+    QVector<QPair<int, int>> portions;
+    double maxValue = 0.0;
+    for (const QVector<QPointF> &points : reduites) {
+        auto parX = [](const QPointF &point, double x) { return point.x() < x; };
+        int debut = int(std::lower_bound(points.cbegin(), points.cend(), m_debut, parX) - points.cbegin());
+        int fin = int(std::lower_bound(points.cbegin(), points.cend(), m_fin, parX) - points.cbegin());
+        debut = qMax(0, debut - 1);
+        fin = qMin(int(points.size()) - 1, fin);
+        portions.append(qMakePair(debut, fin));
+        for (int i = debut; i <= fin; ++i)
+            maxValue = qMax(maxValue, points[i].y());
+    }
+    if (maxValue <= 0.0)
+        maxValue = 1.0;
+
+    // Axes et graduation maximale
+    painter.setFont(QFont("Arial", 9));
+    painter.setPen(QPen(QColor(200, 200, 200), 1));
+    painter.drawLine(plot.bottomLeft(), plot.bottomRight());
+    painter.drawLine(plot.bottomLeft(), plot.topLeft());
+    painter.setPen(QColor(26, 48, 9));
+    painter.drawText(QRect(0, plot.top() - 8, plot.left() - 6, 16), Qt::AlignRight | Qt::AlignVCenter,
+                     QString::number(maxValue, 'f', 0));
+    painter.drawText(QRect(0, plot.bottom() - 8, plot.left() - 6, 16), Qt::AlignRight | Qt::AlignVCenter, "0");
+
+    auto xAt = [&](double index) {
+        return etendue > 0.0 ? plot.left() + plot.width() * (index - m_debut) / etendue : plot.center().x();
+    };
+
+    // Premier et dernier libellé de la fenêtre visible
+    painter.drawText(QRect(plot.left(), plot.bottom() + 4, plot.width() / 2, 16), Qt::AlignLeft,
+                     m_labels[int(std::ceil(m_debut))]);
+    painter.drawText(QRect(plot.center().x(), plot.bottom() + 4, plot.width() / 2, 16), Qt::AlignRight,
+                     m_labels[int(std::floor(m_fin))]);
+
+    int legendX = plot.left();
+    for (int s = 0; s < m_series.size(); ++s) {
+        const Series &serie = m_series[s];
+        const QVector<QPointF> &points = reduites[s];
+
+        QPolygonF line;
+        line.reserve(portions[s].second - portions[s].first + 1);
+        for (int i = portions[s].first; i <= portions[s].second && !points.isEmpty(); ++i)
+            line << QPointF(xAt(points[i].x()), plot.bottom() - plot.height() * points[i].y() / maxValue);
+
+        painter.save();
+        painter.setClipRect(plot.adjusted(0, -2, 0, 2));
+        painter.setPen(QPen(serie.couleur, 2));
+        painter.drawPolyline(line);
+        painter.restore();
+
+        painter.setBrush(serie.couleur);
+        painter.setPen(Qt::NoPen);
+        painter.drawRect(legendX, 6, 12, 12);
+        painter.setPen(QColor(26, 48, 9));
+        painter.setFont(QFont("Arial", 9, QFont::Bold));
+        painter.drawText(legendX + 16, 16, serie.nom);
+        legendX += 16 + QFontMetrics(painter.font()).horizontalAdvance(serie.nom) + 20;
+    }
+}
+
+void LineChartWidget::wheelEvent(QWheelEvent *event)
+{
+    const int count = pointCount();
+    const QRect plot = plotRect();
+    if (count < 2 || plot.width() <= 0) {
+        event->ignore();
+        return;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    const double x = event->position().x();
+#else
+    const double x = event->posF().x();
+#endif
+    // Zoom centré sur l'abscisse sous le curseur
+    const double etendue = m_fin - m_debut;
+    const double ratio = qBound(0.0, (x - plot.left()) / plot.width(), 1.0);
+    const double ancre = m_debut + etendue * ratio;
+    const double facteur = event->angleDelta().y() > 0 ? 1.0 / 1.25 : 1.25;
+
+    const double nouvelle = etendue * facteur;
+    m_debut = ancre - nouvelle * ratio;
+    m_fin = m_debut + nouvelle;
+    clampWindow();
+    update();
+    event->accept();
+}
+
+void LineChartWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton || pointCount() < 2) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    m_dragOrigin = event->position().x();
+#else
+    m_dragOrigin = event->localPos().x();
+#endif
+    m_dragDebut = m_debut;
+    m_dragging = true;
+    setCursor(Qt::ClosedHandCursor);
+}
+
+void LineChartWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!m_dragging) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    const double x = event->position().x();
+#else
+    const double x = event->localPos().x();
+#endif
+    // Déplacement : seule la découpe du cache change, aucune réduction
+    const double etendue = m_fin - m_debut;
+    m_debut = m_dragDebut - (x - m_dragOrigin) * etendue / qMax(1, plotRect().width());
+    m_fin = m_debut + etendue;
+    clampWindow();
+    update();
+}
+
+void LineChartWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (m_dragging && event->button() == Qt::LeftButton) {
+        m_dragging = false;
+        setCursor(Qt::OpenHandCursor);
+        return;
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void LineChartWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    Q_UNUSED(event);
+    m_debut = 0.0;
+    m_fin = qMax(0, pointCount() - 1);
+    update();
+}
+
+// =======================
+// HistogramWidget (implementation)
+// =======================
+HistogramWidget::HistogramWidget(QWidget *parent)
+    : QWidget(parent)
+{
+}
+
+void HistogramWidget::setData(const QStringList &labels, const QVector<int> &counts)
+{
+    m_labels = labels;
+    m_counts = counts;
     update();
 }
 
-void PieChartWidget::paintEvent(QPaintEvent *event)
+void HistogramWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    const int maxCount = m_counts.isEmpty() ? 0 : *std::max_element(m_counts.constBegin(), m_counts.constEnd());
+    if (maxCount == 0) {
+        painter.setPen(QColor(74, 106, 42));
+        painter.setFont(QFont("Arial", 11, QFont::Bold));
+        painter.drawText(rect(), Qt::AlignCenter, "Aucun rendement calculé.");
+        return;
+    }
+
+    const int margin = 10;
+    const int labelHeight = 18;
+    QRect plot(margin, margin, width() - margin * 2, height() - margin * 2 - labelHeight);
+    if (plot.width() <= 0 || plot.height() <= 0)
+        return;
+
+    const double barWidth = double(plot.width()) / m_counts.size();
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(92, 122, 58));
+    for (int i = 0; i < m_counts.size(); ++i) {
+        const double barHeight = plot.height() * double(m_counts[i]) / maxCount;
+        painter.drawRect(QRectF(plot.left() + i * barWidth + 1, plot.bottom() - barHeight,
+                                qMax(1.0, barWidth - 2), barHeight));
+    }
+
+    painter.setPen(QPen(QColor(200, 200, 200), 1));
+    painter.drawLine(plot.bottomLeft(), plot.bottomRight());
+
+    // Libellés des classes extrêmes et effectif maximal
+    painter.setPen(QColor(26, 48, 9));
+    painter.setFont(QFont("Arial", 9));
+    if (!m_labels.isEmpty()) {
+        painter.drawText(QRect(plot.left(), plot.bottom() + 2, plot.width() / 2, labelHeight), Qt::AlignLeft, m_labels.first());
+        painter.drawText(QRect(plot.center().x(), plot.bottom() + 2, plot.width() / 2, labelHeight), Qt::AlignRight, m_labels.last());
+    }
+    painter.drawText(QRect(plot.left(), 0, plot.width(), margin + 4), Qt::AlignRight,
+                     QString("max %1 lot%2").arg(maxCount).arg(maxCount > 1 ? "s" : ""));
+}
+
+// =======================
+// Thème OLIVERAQ (implementation)
+// =======================
+
+static const char *const ThemeRoleProperty = "oliveraqRole";
+
+namespace {
+
+using Role = OliveraqTheme::Role;
+
+QColor couleur(OliveraqTheme::Couleur c)
+{
+    return QColor(QRgb(c));
+}
+
+// Rôles dont le fond est peint par OliveraqStyle au titre de PE_Widget
+bool roleHasBackground(Role role)
+{
+    switch (role) {
+    case OliveraqTheme::PageDegradee:
+    case OliveraqTheme::PageStock:
+    case OliveraqTheme::Bandeau:
+    case OliveraqTheme::Carte:
+    case OliveraqTheme::PanneauBlanc:
+    case OliveraqTheme::PanneauLateral:
+    case OliveraqTheme::Indicateur:
+    case OliveraqTheme::Enonce:
+    case OliveraqTheme::RetourBilan:
+    case OliveraqTheme::RetourSucces:
+    case OliveraqTheme::RetourErreur:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isButtonRole(Role role)
+{
+    return role >= OliveraqTheme::BoutonDefaut && role <= OliveraqTheme::BoutonStock;
+}
+
+bool isTableRole(Role role)
+{
+    return role == OliveraqTheme::Tableau || role == OliveraqTheme::TableauStock;
+}
+
+// Marges intérieures (horizontale, verticale) des boutons
+QSize buttonPadding(Role role)
+{
+    switch (role) {
+    case OliveraqTheme::BoutonPrincipal:
+    case OliveraqTheme::BoutonSecondaire: return QSize(24, 11);
+    case OliveraqTheme::BoutonMenu:       return QSize(20, 16);
+    case OliveraqTheme::BoutonLateral:    return QSize(12, 12);
+    case OliveraqTheme::BoutonStock:      return QSize(20, 10);
+    default:                              return QSize(8, 8);
+    }
+}
+
+bool isLeftAligned(Role role)
+{
+    return role == OliveraqTheme::BoutonMenu || role == OliveraqTheme::BoutonLateral;
+}
+
+void setFontSpec(QWidget *widget, int pixelSize, QFont::Weight weight, bool italic = false)
+{
+    QFont font = widget->font();
+    if (pixelSize > 0)
+        font.setPixelSize(pixelSize);
+    font.setWeight(weight);
+    font.setItalic(italic);
+    widget->setFont(font);
+}
+
+void setTextColor(QWidget *widget, OliveraqTheme::Couleur c)
+{
+    QPalette pal = widget->palette();
+    pal.setColor(QPalette::WindowText, couleur(c));
+    pal.setColor(QPalette::ButtonText, couleur(c));
+    pal.setColor(QPalette::Text, couleur(c));
+    widget->setPalette(pal);
+}
+
+void setPadding(QWidget *widget, int left, int top, int right, int bottom)
+{
+    if (QLabel *label = qobject_cast<QLabel *>(widget))
+        label->setContentsMargins(left, top, right, bottom);
+}
+
+void fillRounded(QPainter *painter, const QRectF &rect, const QBrush &brush, qreal radius,
+                 const QPen &pen = QPen(Qt::NoPen))
+{
+    painter->setPen(pen);
+    painter->setBrush(brush);
+    if (radius > 0)
+        painter->drawRoundedRect(rect, radius, radius);
+    else
+        painter->drawRect(rect);
+}
+
+// Les pages de stock et de ventes habillent les widgets qui n'ont pas de rôle propre
+bool insideStockPage(const QWidget *widget)
+{
+    for (const QWidget *w = widget->parentWidget(); w; w = w->parentWidget()) {
+        if (OliveraqTheme::roleOf(w) == OliveraqTheme::PageStock)
+            return true;
+    }
+    return false;
+}
+
+} // namespace
+
+OliveraqTheme::Role OliveraqTheme::roleOf(const QWidget *widget)
+{
+    if (!widget)
+        return Aucun;
+    const QVariant value = widget->property(ThemeRoleProperty);
+    return value.isValid() ? Role(value.toInt()) : Aucun;
+}
+
+QPalette OliveraqTheme::palette()
+{
+    QPalette pal = QApplication::palette();
+    pal.setColor(QPalette::Window, couleur(FondApplication));
+    pal.setColor(QPalette::Base, couleur(Blanc));
+    return pal;
+}
+
+void OliveraqTheme::apply(QWidget *widget, Role role)
+{
+    widget->setProperty(ThemeRoleProperty, int(role));
+    widget->setAttribute(Qt::WA_StyledBackground, roleHasBackground(role));
+
+    switch (role) {
+    case Aucun:
+    case PageDegradee:
+    case Bandeau:
+    case Carte:
+    case PanneauBlanc:
+    case PanneauLateral:
+        break;
+    case PageStock: {
+        QPalette pal = widget->palette();
+        pal.setColor(QPalette::Window, couleur(Beige));
+        widget->setPalette(pal);
+        break;
+    }
+
+    case TitreCarte:     setFontSpec(widget, 28, QFont::DemiBold); setTextColor(widget, OliveFonce); break;
+    case SousTitreCarte: setFontSpec(widget, 13, QFont::Normal);   setTextColor(widget, Olive);      break;
+    case LibelleChamp:   setFontSpec(widget, 13, QFont::Medium);   setTextColor(widget, OliveFonce); break;
+    case TitreBandeau:   setFontSpec(widget, 24, QFont::DemiBold); setTextColor(widget, Blanc);      break;
+    case TitreMenu:      setFontSpec(widget, 18, QFont::Bold);     setTextColor(widget, Blanc);      break;
+    case Titre:          setFontSpec(widget, 20, QFont::Bold);     setTextColor(widget, Mousse);     break;
+    case TitreSection:   setFontSpec(widget, 16, QFont::Bold);     setTextColor(widget, StockFonce); break;
+    case SousSection:    setFontSpec(widget, 16, QFont::Bold);     setTextColor(widget, OliveFonce); break;
+    case LibelleSection: setFontSpec(widget, 0, QFont::Bold);      setTextColor(widget, StockFonce); break;
+    case Annotation:     setFontSpec(widget, 0, QFont::Normal, true); setTextColor(widget, StockFonce); break;
+    case TexteStock:     setFontSpec(widget, 12, QFont::Bold);     setTextColor(widget, StockEncre); break;
+    case Progression:    setFontSpec(widget, 13, QFont::Medium);   setTextColor(widget, Olivier);    break;
+    case Indicateur:
+        setFontSpec(widget, 0, QFont::Bold);
+        setPadding(widget, 10, 10, 10, 10);
+        break;
+    case Enonce:
+        setFontSpec(widget, 16, QFont::Medium);
+        setTextColor(widget, Encre);
+        setPadding(widget, 15, 15, 15, 15);
+        break;
+    case Retour:
+        setFontSpec(widget, 13, QFont::Normal);
+        setTextColor(widget, Encre);
+        setPadding(widget, 12, 12, 12, 12);
+        break;
+    case RetourBilan:
+        setFontSpec(widget, 16, QFont::Bold);
+        setTextColor(widget, Encre);
+        setPadding(widget, 20, 20, 20, 20);
+        break;
+    case RetourSucces:
+    case RetourErreur:
+        // Le filet gauche de 4 px s'ajoute à la marge intérieure
+        setFontSpec(widget, 13, QFont::Normal);
+        setTextColor(widget, role == RetourSucces ? VertSucces : RougeErreur);
+        setPadding(widget, 16, 12, 12, 12);
+        break;
+
+    case BoutonDefaut:     setFontSpec(widget, 14, QFont::Normal);   setTextColor(widget, Blanc);      break;
+    case BoutonPrincipal:  setFontSpec(widget, 14, QFont::DemiBold); setTextColor(widget, Blanc);      break;
+    case BoutonSecondaire: setFontSpec(widget, 14, QFont::DemiBold); setTextColor(widget, OliveFonce); break;
+    case BoutonMenu:       setFontSpec(widget, 14, QFont::Medium);   setTextColor(widget, Encre);      break;
+    case BoutonLateral:    setFontSpec(widget, 13, QFont::Normal);   setTextColor(widget, Blanc);      break;
+    case BoutonStock:      setFontSpec(widget, 14, QFont::Bold);     setTextColor(widget, Blanc);      break;
+
+    case Champ:
+    case ChampStock: {
+        setFontSpec(widget, role == Champ ? 14 : 12, QFont::Normal);
+        QPalette pal = widget->palette();
+        pal.setColor(QPalette::Base, couleur(Blanc));
+        pal.setColor(QPalette::Text, couleur(role == Champ ? Encre : StockEncre));
+        widget->setPalette(pal);
+        if (QLineEdit *edit = qobject_cast<QLineEdit *>(widget)) {
+            if (role == Champ)
+                edit->setTextMargins(10, 0, 10, 0);
+            else
+                edit->setTextMargins(3, 0, 3, 0);
+        }
+        break;
+    }
+    case Option:
+        setFontSpec(widget, 14, QFont::Normal);
+        setTextColor(widget, Encre);
+        break;
+
+    case Tableau:
+    case TableauStock: {
+        QTableView *table = qobject_cast<QTableView *>(widget);
+        if (!table)
+            break;
+        QPalette pal = table->palette();
+        pal.setColor(QPalette::Base, couleur(Blanc));
+        table->setPalette(pal);
+        for (QHeaderView *header : {table->horizontalHeader(), table->verticalHeader()}) {
+            header->setProperty(ThemeRoleProperty, int(role));
+            if (role == Tableau) {
+                setFontSpec(header, 0, QFont::DemiBold);
+                setTextColor(header, OliveFonce);
+            } else {
+                setFontSpec(header, 10, QFont::Bold);
+                setTextColor(header, StockEncre);
+            }
+        }
+        if (role == Tableau)
+            table->verticalHeader()->setDefaultSectionSize(table->fontMetrics().height() + 16);
+        break;
+    }
+    }
+
+    if (isButtonRole(role) || role == Champ || role == ChampStock || role == Option)
+        widget->setAttribute(Qt::WA_Hover);
+    widget->update();
+}
+
+// =======================
+// OliveraqStyle
+// =======================
+
+OliveraqStyle::OliveraqStyle()
+    : QProxyStyle(QStyleFactory::create("Fusion"))
+{
+}
+
+void OliveraqStyle::polish(QWidget *widget)
+{
+    QProxyStyle::polish(widget);
+
+    if (widget->property(ThemeRoleProperty).isValid() || !insideStockPage(widget))
+        return;
+    // Les éditeurs internes des spin box et combo box restent sans cadre
+    QWidget *parent = widget->parentWidget();
+    if (qobject_cast<QAbstractSpinBox *>(parent) || qobject_cast<QComboBox *>(parent))
+        return;
+
+    if (qobject_cast<QLabel *>(widget))
+        OliveraqTheme::apply(widget, OliveraqTheme::TexteStock);
+    else if (qobject_cast<QPushButton *>(widget))
+        OliveraqTheme::apply(widget, OliveraqTheme::BoutonStock);
+    else if (qobject_cast<QLineEdit *>(widget) || qobject_cast<QComboBox *>(widget)
+             || qobject_cast<QAbstractSpinBox *>(widget))
+        OliveraqTheme::apply(widget, OliveraqTheme::ChampStock);
+    else if (qobject_cast<QTableView *>(widget))
+        OliveraqTheme::apply(widget, OliveraqTheme::TableauStock);
+}
+
+void OliveraqStyle::drawPanneauChamp(OliveraqTheme::Role role, const QStyleOption *option, QPainter *painter) const
+{
+    const bool focus = option->state & State_HasFocus;
+    const bool hover = (option->state & State_MouseOver) && (option->state & State_Enabled);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    if (role == OliveraqTheme::Champ) {
+        const int largeur = focus ? 2 : 1;
+        const QColor bord = focus ? couleur(OliveraqTheme::Olive)
+                          : hover ? couleur(OliveraqTheme::OliveGris)
+                                  : couleur(OliveraqTheme::BordureChamp);
+        const QColor fond = focus ? couleur(OliveraqTheme::CremeOlive) : option->palette.color(QPalette::Base);
+        const qreal demi = largeur / 2.0;
+        fillRounded(painter, QRectF(option->rect).adjusted(demi, demi, -demi, -demi), fond, 6, QPen(bord, largeur));
+    } else {
+        fillRounded(painter, QRectF(option->rect).adjusted(0.5, 0.5, -0.5, -0.5), option->palette.color(QPalette::Base), 4,
+                    QPen(couleur(OliveraqTheme::Mousse), 1));
+    }
+    painter->restore();
+}
+
+void OliveraqStyle::drawBouton(OliveraqTheme::Role role, const QStyleOption *option, QPainter *painter) const
+{
+    using T = OliveraqTheme;
+    const bool enabled = option->state & State_Enabled;
+    const bool down = option->state & (State_Sunken | State_On);
+    const bool hover = enabled && (option->state & State_MouseOver);
+    const QRectF r = QRectF(option->rect).adjusted(0.5, 0.5, -0.5, -0.5);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    if (!enabled)
+        painter->setOpacity(0.6);
+
+    switch (role) {
+    case T::BoutonPrincipal: {
+        QLinearGradient gradient(r.topLeft(), r.bottomLeft());
+        gradient.setColorAt(0, couleur(down ? T::OliveFonce : hover ? T::OliveVif : T::Olive));
+        gradient.setColorAt(1, couleur(down ? T::OliveNuit : hover ? T::Olive : T::OliveFonce));
+        fillRounded(painter, r, gradient, 6);
+        break;
+    }
+    case T::BoutonSecondaire:
+        fillRounded(painter, r.adjusted(0.5, 0.5, -0.5, -0.5),
+                    couleur(down ? T::CremePresse : hover ? T::CremeOlive : T::Blanc), 6,
+                    QPen(couleur(hover ? T::OliveFonce : T::Olive), 2));
+        break;
+    case T::BoutonMenu: {
+        fillRounded(painter, r, couleur(down ? T::CremePresse : hover ? T::CremeOlive : T::Blanc), 0,
+                    QPen(couleur(T::BordureClaire), 1));
+        const QRectF filet(option->rect.left(), option->rect.top(), 4, option->rect.height());
+        painter->fillRect(filet, couleur(down ? T::OliveFonce : hover ? T::Olive : T::Nuage));
+        break;
+    }
+    case T::BoutonLateral:
+        fillRounded(painter, r, couleur(hover ? T::SaugeClair : T::Sauge), 6);
+        break;
+    case T::BoutonStock:
+        fillRounded(painter, r, couleur(down ? T::StockFonce : hover ? T::StockSurvol : T::StockBouton), 4,
+                    QPen(couleur(T::StockFonce), 1));
+        break;
+    default:
+        fillRounded(painter, r, couleur(hover ? T::SaugeClair : T::Sauge), 6);
+        break;
+    }
+    painter->restore();
+}
+
+void OliveraqStyle::drawPrimitive(PrimitiveElement element, const QStyleOption *option,
+                                  QPainter *painter, const QWidget *widget) const
+{
+    using T = OliveraqTheme;
+    const Role role = T::roleOf(widget);
+
+    switch (element) {
+    case PE_Widget: {
+        if (!roleHasBackground(role))
+            break;
+        const QRectF r = QRectF(option->rect);
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+        switch (role) {
+        case T::PageDegradee: {
+            QLinearGradient gradient(r.topLeft(), r.bottomRight());
+            gradient.setColorAt(0, couleur(T::OliveFonce));
+            gradient.setColorAt(0.25, couleur(T::Olive));
+            gradient.setColorAt(0.5, couleur(T::Olivier));
+            gradient.setColorAt(0.75, couleur(T::Olive));
+            gradient.setColorAt(1, couleur(T::OliveFonce));
+            painter->fillRect(r, gradient);
+            break;
+        }
+        case T::Bandeau: {
+            QLinearGradient gradient(r.topLeft(), r.topRight());
+            gradient.setColorAt(0, couleur(T::OliveFonce));
+            gradient.setColorAt(1, couleur(T::Olive));
+            painter->fillRect(r, gradient);
+            painter->fillRect(QRectF(r.left(), r.bottom() - 3, r.width(), 3), couleur(T::OliveNuit));
+            break;
+        }
+        case T::PageStock:      painter->fillRect(r, couleur(T::Beige)); break;
+        case T::Carte:          fillRounded(painter, r, couleur(T::Blanc), 12); break;
+        case T::PanneauBlanc:   painter->fillRect(r, couleur(T::Blanc)); break;
+        case T::PanneauLateral: painter->fillRect(r, couleur(T::Mousse)); break;
+        case T::Indicateur:     fillRounded(painter, r, couleur(T::VertPale), 6); break;
+        case T::Enonce:         fillRounded(painter, r, couleur(T::FondEnonce), 8); break;
+        case T::RetourBilan:    fillRounded(painter, r, couleur(T::VertPale), 8); break;
+        case T::RetourSucces:
+        case T::RetourErreur: {
+            const bool succes = role == T::RetourSucces;
+            fillRounded(painter, r, couleur(succes ? T::VertPale : T::RougePale), 6);
+            painter->setClipRect(QRectF(r.left(), r.top(), 4, r.height()));
+            fillRounded(painter, r, couleur(succes ? T::VertFilet : T::RougeFilet), 6);
+            break;
+        }
+        default:
+            break;
+        }
+        painter->restore();
+        return;
+    }
+    case PE_PanelLineEdit:
+        if (role == T::Champ || role == T::ChampStock) {
+            drawPanneauChamp(role, option, painter);
+            return;
+        }
+        if (const QLineEdit *edit = qobject_cast<const QLineEdit *>(widget); edit && edit->isReadOnly()) {
+            QStyleOption copy(*option);
+            copy.palette.setColor(QPalette::Base, couleur(T::LectureSeule));
+            QProxyStyle::drawPrimitive(element, &copy, painter, widget);
+            return;
+        }
+        break;
+    case PE_IndicatorRadioButton:
+        if (role == T::Option) {
+            const bool checked = option->state & State_On;
+            const bool hover = option->state & State_MouseOver;
+            painter->save();
+            painter->setRenderHint(QPainter::Antialiasing);
+            const QRectF r = QRectF(option->rect).adjusted(1, 1, -1, -1);
+            if (checked)
+                fillRounded(painter, r, couleur(T::Olive), r.width() / 2, QPen(couleur(T::OliveFonce), 2));
+            else
+                fillRounded(painter, r, couleur(T::Blanc), r.width() / 2,
+                            QPen(couleur(hover ? T::OliveGris : T::BordureChamp), 1.5));
+            painter->restore();
+            return;
+        }
+        break;
+    case PE_FrameFocusRect:
+        // Les boutons signalent leur état par la couleur, sans cadre pointillé
+        if (qobject_cast<const QPushButton *>(widget))
+            return;
+        break;
+    default:
+        break;
+    }
+    QProxyStyle::drawPrimitive(element, option, painter, widget);
+}
+
+void OliveraqStyle::drawControl(ControlElement element, const QStyleOption *option,
+                                QPainter *painter, const QWidget *widget) const
+{
+    using T = OliveraqTheme;
+    Role role = T::roleOf(widget);
+
+    switch (element) {
+    case CE_PushButtonBevel:
+        if (qobject_cast<const QPushButton *>(widget)) {
+            drawBouton(isButtonRole(role) ? role : T::BoutonDefaut, option, painter);
+            return;
+        }
+        break;
+    case CE_PushButtonLabel:
+        if (const QStyleOptionButton *button = qstyleoption_cast<const QStyleOptionButton *>(option);
+            button && qobject_cast<const QPushButton *>(widget)) {
+            if (!isButtonRole(role))
+                role = T::BoutonDefaut;
+            const bool hover = (option->state & State_Enabled) && (option->state & State_MouseOver);
+            const bool down = option->state & (State_Sunken | State_On);
+
+            QStyleOptionButton copy(*button);
+            if (role == T::BoutonMenu && (hover || down))
+                copy.palette.setColor(QPalette::ButtonText, couleur(down ? T::OliveNuit : T::OliveFonce));
+            else if (role == T::BoutonSecondaire && hover)
+                copy.palette.setColor(QPalette::ButtonText, couleur(T::OliveNuit));
+
+            if (!isLeftAligned(role)) {
+                QProxyStyle::drawControl(element, &copy, painter, widget);
+                return;
+            }
+
+            const int marge = buttonPadding(role).width() + (role == T::BoutonMenu ? 4 : 0);
+            QRect textRect = copy.rect.adjusted(marge, 0, -marge, 0);
+            if (!copy.icon.isNull()) {
+                const QPixmap pixmap = copy.icon.pixmap(copy.iconSize,
+                                                        (copy.state & State_Enabled) ? QIcon::Normal : QIcon::Disabled);
+                const QRect iconRect(textRect.left(), textRect.center().y() - copy.iconSize.height() / 2,
+                                     copy.iconSize.width(), copy.iconSize.height());
+                painter->drawPixmap(iconRect, pixmap);
+                textRect.setLeft(iconRect.right() + 8);
+            }
+            proxy()->drawItemText(painter, textRect, Qt::AlignLeft | Qt::AlignVCenter | Qt::TextShowMnemonic,
+                                  copy.palette, bool(copy.state & State_Enabled), copy.text, QPalette::ButtonText);
+            return;
+        }
+        break;
+    case CE_ShapedFrame:
+        if (isTableRole(role)) {
+            painter->save();
+            painter->setRenderHint(QPainter::Antialiasing);
+            const bool stock = role == T::TableauStock;
+            fillRounded(painter, QRectF(option->rect).adjusted(0.5, 0.5, -0.5, -0.5), Qt::NoBrush, stock ? 0 : 6,
+                        QPen(couleur(stock ? T::Mousse : T::BordureClaire), 1));
+            painter->restore();
+            return;
+        }
+        break;
+    case CE_HeaderSection:
+        if (isTableRole(role)) {
+            if (role == T::Tableau) {
+                painter->fillRect(option->rect, couleur(T::EnTeteClair));
+                painter->setPen(couleur(T::BordureClaire));
+                painter->drawRect(option->rect.adjusted(0, 0, -1, -1));
+            } else {
+                painter->fillRect(option->rect, couleur(T::Ciel));
+            }
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+    QProxyStyle::drawControl(element, option, painter, widget);
+}
+
+void OliveraqStyle::drawComplexControl(ComplexControl control, const QStyleOptionComplex *option,
+                                       QPainter *painter, const QWidget *widget) const
+{
+    const Role role = OliveraqTheme::roleOf(widget);
+    if (control == CC_ComboBox && (role == OliveraqTheme::Champ || role == OliveraqTheme::ChampStock)) {
+        QStyleOption panneau(*option);
+        // Au survol, le champ de tri prend la bordure de focus
+        if (role == OliveraqTheme::Champ && (option->state & State_MouseOver))
+            panneau.state |= State_HasFocus;
+        drawPanneauChamp(role, &panneau, painter);
+
+        QStyleOption fleche(*option);
+        fleche.rect = proxy()->subControlRect(CC_ComboBox, option, SC_ComboBoxArrow, widget).adjusted(2, 4, -6, -4);
+        fleche.palette.setColor(QPalette::ButtonText, couleur(OliveraqTheme::Encre));
+        fleche.palette.setColor(QPalette::WindowText, couleur(OliveraqTheme::Encre));
+        proxy()->drawPrimitive(PE_IndicatorArrowDown, &fleche, painter, widget);
+        return;
+    }
+    QProxyStyle::drawComplexControl(control, option, painter, widget);
+}
+
+QSize OliveraqStyle::sizeFromContents(ContentsType type, const QStyleOption *option,
+                                      const QSize &size, const QWidget *widget) const
+{
+    using T = OliveraqTheme;
+    Role role = T::roleOf(widget);
+
+    switch (type) {
+    case CT_PushButton:
+        if (qobject_cast<const QPushButton *>(widget)) {
+            if (!isButtonRole(role))
+                role = T::BoutonDefaut;
+            const QSize padding = buttonPadding(role);
+            QSize result = size + QSize(padding.width() * 2 + 2, padding.height() * 2 + 2);
+            if (role == T::BoutonMenu)
+                result.setHeight(qMax(result.height(), 50 + padding.height() * 2 + 2));
+            return result;
+        }
+        break;
+    case CT_LineEdit:
+        if (role == T::Champ)
+            return size + QSize(0, 16);
+        if (role == T::ChampStock)
+            return size + QSize(0, 6);
+        break;
+    case CT_ComboBox:
+        if (role == T::Champ)
+            return QProxyStyle::sizeFromContents(type, option, size, widget) + QSize(12, 12);
+        if (role == T::ChampStock)
+            return QProxyStyle::sizeFromContents(type, option, size, widget) + QSize(4, 4);
+        break;
+    case CT_RadioButton:
+        if (role == T::Option)
+            return QProxyStyle::sizeFromContents(type, option, size, widget) + QSize(10, 20);
+        break;
+    case CT_HeaderSection:
+        if (isTableRole(role)) {
+            const int pad = role == T::Tableau ? 10 : 6;
+            return QProxyStyle::sizeFromContents(type, option, size, widget) + QSize(pad, pad);
+        }
+        break;
+    default:
+        break;
+    }
+    return QProxyStyle::sizeFromContents(type, option, size, widget);
+}
+
+int OliveraqStyle::pixelMetric(PixelMetric metric, const QStyleOption *option, const QWidget *widget) const
+{
+    const Role role = OliveraqTheme::roleOf(widget);
+    switch (metric) {
+    case PM_ExclusiveIndicatorWidth:
+    case PM_ExclusiveIndicatorHeight:
+        if (role == OliveraqTheme::Option)
+            return 18;
+        break;
+    case PM_DefaultFrameWidth:
+        if (isTableRole(role))
+            return 1;
+        break;
+    default:
+        break;
+    }
+    return QProxyStyle::pixelMetric(metric, option, widget);
+}
+
+int OliveraqStyle::styleHint(StyleHint hint, const QStyleOption *option, const QWidget *widget,
+                             QStyleHintReturn *returnData) const
+{
+    if (hint == SH_Table_GridLineColor) {
+        const Role role = OliveraqTheme::roleOf(widget);
+        if (isTableRole(role)) {
+            const QColor grille = couleur(role == OliveraqTheme::Tableau ? OliveraqTheme::BordureClaire
+                                                                          : OliveraqTheme::GrilleStock);
+            return int(grille.rgba());
+        }
+    }
+    return QProxyStyle::styleHint(hint, option, widget, returnData);
+}
+
+// =======================
+// DateSchedule
+// =======================
+void DateSchedule::schedule(const QDate &date, quint64 id)
+{
+    m_entries[date].append(id);
+}
+
+void DateSchedule::cancel(const QDate &date, quint64 id)
+{
+    auto it = m_entries.find(date);
+    if (it == m_entries.end())
+        return;
+    it->removeOne(id);
+    if (it->isEmpty())
+        m_entries.erase(it);
+}
+
+QVector<quint64> DateSchedule::takeDue(const QDate &today)
+{
+    QVector<quint64> due;
+    auto it = m_entries.begin();
+    while (it != m_entries.end() && it.key() <= today) {
+        due += it.value();
+        it = m_entries.erase(it);
+    }
+    return due;
+}
+
+QDate DateSchedule::nextDate() const
+{
+    return m_entries.isEmpty() ? QDate() : m_entries.firstKey();
+}
+
+// =======================
+// AgeBucketIndex
+// =======================
+// Tranches : < 30 ans, 30-50 ans, > 50 ans (âge calendaire exact)
+AgeBucketIndex::AgeBucketIndex()
+    : m_today(QDate::currentDate())
+{
+}
+
+AgeBucketIndex::Bucket AgeBucketIndex::bucketFor(const QDate &dateNaissance, const QDate &today)
+{
+    if (today < dateNaissance.addYears(30))
+        return Jeunes;
+    if (today < dateNaissance.addYears(51))
+        return Adultes;
+    return Seniors;
+}
+
+QDate AgeBucketIndex::nextTransitionFor(const QDate &dateNaissance, Bucket bucket)
+{
+    switch (bucket) {
+    case Jeunes:
+        return dateNaissance.addYears(30);
+    case Adultes:
+        return dateNaissance.addYears(51);
+    default:
+        return QDate();
+    }
+}
+
+void AgeBucketIndex::insert(quint64 id, const QDate &dateNaissance)
+{
+    remove(id);
+
+    Entry entry;
+    entry.dateNaissance = dateNaissance;
+    entry.bucket = bucketFor(dateNaissance, m_today);
+    entry.nextTransition = nextTransitionFor(dateNaissance, entry.bucket);
+
+    m_counts[entry.bucket]++;
+    if (entry.nextTransition.isValid())
+        m_schedule.schedule(entry.nextTransition, id);
+    m_entries.insert(id, entry);
+}
+
+void AgeBucketIndex::remove(quint64 id)
+{
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return;
+
+    m_counts[it->bucket]--;
+    if (it->nextTransition.isValid())
+        m_schedule.cancel(it->nextTransition, id);
+    m_entries.erase(it);
+}
+
+void AgeBucketIndex::advanceTo(const QDate &today)
+{
+    if (today <= m_today)
+        return;
+    m_today = today;
+
+    const QVector<quint64> due = m_schedule.takeDue(today);
+    for (quint64 id : due) {
+        auto it = m_entries.find(id);
+        if (it == m_entries.end())
+            continue;
+
+        m_counts[it->bucket]--;
+        it->bucket = bucketFor(it->dateNaissance, today);
+        it->nextTransition = nextTransitionFor(it->dateNaissance, it->bucket);
+        m_counts[it->bucket]++;
+        if (it->nextTransition.isValid())
+            m_schedule.schedule(it->nextTransition, id);
+    }
+}
+
+// =======================
+// AgingIndex
+// =======================
+// Tranches : 0-30, 31-60, 61-90 et plus de 90 jours depuis la commande
+AgingIndex::AgingIndex()
+    : m_today(QDate::currentDate())
+{
+}
+
+AgingIndex::Bucket AgingIndex::bucketFor(const QDate &dateCommande, const QDate &today)
+{
+    const qint64 jours = dateCommande.daysTo(today);
+    if (jours <= 30)
+        return Jours0_30;
+    if (jours <= 60)
+        return Jours31_60;
+    if (jours <= 90)
+        return Jours61_90;
+    return Plus90;
+}
+
+QDate AgingIndex::nextTransitionFor(const QDate &dateCommande, Bucket bucket)
+{
+    switch (bucket) {
+    case Jours0_30:
+        return dateCommande.addDays(31);
+    case Jours31_60:
+        return dateCommande.addDays(61);
+    case Jours61_90:
+        return dateCommande.addDays(91);
+    default:
+        return QDate();
+    }
+}
+
+void AgingIndex::account(const Entry &entry, int sign)
+{
+    m_global.montants[entry.bucket] += sign * entry.reste;
+    m_global.commandes += sign;
+
+    Exposure &exposure = m_partenaires[entry.nom];
+    exposure.montants[entry.bucket] += sign * entry.reste;
+    exposure.commandes += sign;
+    if (exposure.commandes <= 0)
+        m_partenaires.remove(entry.nom);
+}
+
+void AgingIndex::insert(const OrderRecord &order)
+{
+    remove(order.id);
+
+    // Seules les commandes non soldées entrent dans l'encours
+    if (order.resteAPayer <= 0.0 || !order.dateCommande.isValid())
+        return;
+
+    Entry entry;
+    entry.nom = order.nom;
+    entry.dateCommande = order.dateCommande;
+    entry.reste = order.resteAPayer;
+    entry.bucket = bucketFor(order.dateCommande, m_today);
+    entry.nextTransition = nextTransitionFor(order.dateCommande, entry.bucket);
+
+    account(entry, 1);
+    if (entry.nextTransition.isValid())
+        m_schedule.schedule(entry.nextTransition, order.id);
+    m_entries.insert(order.id, entry);
+}
+
+void AgingIndex::remove(quint64 id)
+{
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return;
+
+    account(*it, -1);
+    if (it->nextTransition.isValid())
+        m_schedule.cancel(it->nextTransition, id);
+    m_entries.erase(it);
+}
+
+void AgingIndex::advanceTo(const QDate &today)
+{
+    if (today <= m_today)
+        return;
+    m_today = today;
+
+    const QVector<quint64> due = m_schedule.takeDue(today);
+    for (quint64 id : due) {
+        auto it = m_entries.find(id);
+        if (it == m_entries.end())
+            continue;
+
+        account(*it, -1);
+        it->bucket = bucketFor(it->dateCommande, today);
+        it->nextTransition = nextTransitionFor(it->dateCommande, it->bucket);
+        account(*it, 1);
+        if (it->nextTransition.isValid())
+            m_schedule.schedule(it->nextTransition, id);
+    }
+}
+
+// =======================
+// OrderCounters
+// =======================
+void OrderCounters::apply(const OrderRecord &order, int delta)
+{
+    total += delta;
+    if (order.statut == "En cours") {
+        enCours += delta;
+    } else if (order.statut == "Livrée") {
+        livrees += delta;
+    }
+}
+
+// =======================
+// PartnerPerformanceIndex
+// =======================
+void PartnerPerformanceIndex::apply(const OrderRecord &order, int delta)
+{
+    auto it = m_stats.find(order.nom);
+    if (it == m_stats.end()) {
+        if (delta < 0)
+            return;
+        it = m_stats.insert(order.nom, Stats());
+    }
+
+    it->total += delta;
+    if (order.statut == "Livrée") {
+        it->livrees += delta;
+    }
+
+    if (it->total <= 0) {
+        m_stats.erase(it);
+        m_parTotal.remove(order.nom);
+    } else {
+        m_parTotal.set(order.nom, it->total);
+    }
+}
+
+// =======================
+// LeadTimeIndex
+// =======================
+int LeadTimeIndex::leadTimeDays(const OrderRecord &order)
+{
+    if (order.statut != "Livrée" || !order.dateCommande.isValid() || !order.dateLivraison.isValid())
+        return -1;
+    int days = int(order.dateCommande.daysTo(order.dateLivraison));
+    return days >= 0 ? days : -1;
+}
+
+int LeadTimeIndex::Sketch::quantile(double q) const
+{
+    // Rang le plus proche (nearest-rank) sur l'histogramme cumulé
+    const int rank = qMax(1, int(std::ceil(q * summary.commandes)));
+    int cumulative = 0;
+    for (int day = 0; day < counts.size(); ++day) {
+        cumulative += counts[day];
+        if (cumulative >= rank)
+            return day;
+    }
+    return counts.size() - 1;
+}
+
+void LeadTimeIndex::apply(const OrderRecord &order, int delta)
+{
+    int days = leadTimeDays(order);
+    if (days < 0)
+        return;
+    days = qMin(days, MaxDays);
+
+    auto it = m_sketches.find(order.nom);
+    if (it == m_sketches.end()) {
+        if (delta < 0)
+            return;
+        it = m_sketches.insert(order.nom, Sketch());
+    } else {
+        m_ranking.remove(RankKey{it->summary.p50, it->summary.p90, order.nom});
+    }
+
+    if (it->counts.size() <= days)
+        it->counts.resize(days + 1);
+    it->counts[days] += delta;
+    it->summary.commandes += delta;
+
+    if (it->summary.commandes <= 0) {
+        m_sketches.erase(it);
+        return;
+    }
+
+    it->summary.p50 = it->quantile(0.5);
+    it->summary.p90 = it->quantile(0.9);
+    m_ranking.insert(RankKey{it->summary.p50, it->summary.p90, order.nom}, it->summary);
+}
+
+QVector<LeadTimeIndex::RankedEntry> LeadTimeIndex::ranking(int limit) const
+{
+    QVector<RankedEntry> entries;
+    for (auto it = m_ranking.constBegin(); it != m_ranking.constEnd() && entries.size() < limit; ++it) {
+        entries.append(RankedEntry{it.key().nom, it.value()});
+    }
+    return entries;
+}
+
+// =======================
+// ClientRevenueIndex
+// =======================
+double ClientRevenueIndex::valeurDe(Critere critere, const Stats &stats)
+{
+    switch (critere) {
+    case NombreCommandes:
+        return stats.commandes;
+    case PanierMoyen:
+        return stats.panierMoyen();
+    default:
+        return stats.chiffreAffaires;
+    }
+}
+
+void ClientRevenueIndex::apply(const OrderRecord &order, int sign)
+{
+    auto it = m_stats.find(order.nom);
+    if (it == m_stats.end()) {
+        if (sign < 0)
+            return;
+        it = m_stats.insert(order.nom, Stats());
+    } else {
+        for (int critere = ChiffreAffaires; critere <= PanierMoyen; ++critere)
+            m_classements[critere].remove(RankKey{valeurDe(Critere(critere), *it), order.nom});
+    }
+
+    it->commandes += sign;
+    it->chiffreAffaires += sign * order.prixTTC;
+
+    if (it->commandes <= 0) {
+        m_stats.erase(it);
+        return;
+    }
+    for (int critere = ChiffreAffaires; critere <= PanierMoyen; ++critere)
+        m_classements[critere].insert(RankKey{valeurDe(Critere(critere), *it), order.nom}, *it);
+}
+
+QVector<ClientRevenueIndex::RankedEntry> ClientRevenueIndex::top(Critere critere, int k) const
+{
+    QVector<RankedEntry> entries;
+    const QMap<RankKey, Stats> &classement = m_classements[critere];
+    for (auto it = classement.constBegin(); it != classement.constEnd() && entries.size() < k; ++it)
+        entries.append(RankedEntry{it.key().nom, it.value()});
+    return entries;
+}
+
+// =======================
+// SalesEngine
+// =======================
+QString SalesEngine::produitDe(const OrderRecord &order)
+{
+    const QString produit = order.produit.trimmed();
+    return produit.isEmpty() ? QString("(sans produit)") : produit;
+}
+
+void SalesEngine::modifierProduit(const QString &produit, const std::function<void(ProduitStats &)> &modification)
+{
+    auto it = m_produits.find(produit);
+    if (it == m_produits.end())
+        it = m_produits.insert(produit, ProduitStats());
+    else if (it->commandes > 0)
+        m_classement.remove(RankKey{it->ventesTTC, produit});
+
+    modification(*it);
+
+    if (it->commandes > 0)
+        m_classement.insert(RankKey{it->ventesTTC, produit}, *it);
+    else if (it->achats <= 0)
+        m_produits.erase(it);
+}
+
+void SalesEngine::applyVente(const OrderRecord &order, int sign)
+{
+    m_totaux.commandes += sign;
+    m_totaux.ventesHT += sign * order.prixHT;
+    m_totaux.ventesTTC += sign * order.prixTTC;
+    m_totaux.encaisse += sign * order.avance;
+    m_totaux.resteAEncaisser += sign * order.resteAPayer;
+
+    if (order.dateCommande.isValid()) {
+        Jour &jour = m_jours[order.dateCommande];
+        jour.commandes += sign;
+        jour.ventesTTC += sign * order.prixTTC;
+        if (jour.commandes <= 0)
+            m_jours.remove(order.dateCommande);
+    }
+
+    modifierProduit(produitDe(order), [&](ProduitStats &stats) {
+        stats.commandes += sign;
+        stats.quantite += sign * order.quantite;
+        stats.ventesHT += sign * order.prixHT;
+        stats.ventesTTC += sign * order.prixTTC;
+    });
+}
+
+void SalesEngine::applyAchat(const OrderRecord &order, int sign)
+{
+    m_totaux.achatsHT += sign * order.prixHT;
+
+    modifierProduit(produitDe(order), [&](ProduitStats &stats) {
+        stats.achats += sign;
+        stats.achatsHT += sign * order.prixHT;
+    });
+}
+
+QVector<SalesEngine::RankedProduit> SalesEngine::topProduits(int k) const
+{
+    QVector<RankedProduit> produits;
+    for (auto it = m_classement.constBegin(); it != m_classement.constEnd() && produits.size() < k; ++it)
+        produits.append(RankedProduit{it.key().produit, it.value()});
+    return produits;
+}
+
+// =======================
+// ProductionCube
+// =======================
+QString ProductionCube::moisLibelle(int mois)
+{
+    return QString("%1/%2").arg(mois % 100, 2, 10, QChar('0')).arg(mois / 100);
+}
+
+QString ProductionCube::qualiteDe(const ProductionRecord &record)
+{
+    return record.qualite.isEmpty() ? QString("-") : record.qualite;
+}
+
+QString ProductionCube::cellKey(const Slice &slice)
+{
+    return slice.type + QChar(0x1f) + QString::number(slice.mois) + QChar(0x1f) + slice.qualite;
+}
+
+template <typename Key>
+static void adjustMember(QMap<Key, int> &members, const Key &key, int sign)
+{
+    int &count = members[key];
+    count += sign;
+    if (count <= 0)
+        members.remove(key);
+}
+
+void ProductionCube::apply(const ProductionRecord &record, int sign)
+{
+    const Slice point{record.typeProduit, moisCle(record.dateProduction), qualiteDe(record)};
+
+    // Chaque bit du masque garde une dimension, les autres passent à « toutes »
+    for (int mask = 0; mask < 8; ++mask) {
+        Slice slice;
+        if (mask & 1)
+            slice.type = point.type;
+        if (mask & 2)
+            slice.mois = point.mois;
+        if (mask & 4)
+            slice.qualite = point.qualite;
+
+        const QString key = cellKey(slice);
+        Measures &mesures = m_cells[key];
+        mesures.count += sign;
+        mesures.kg += sign * record.quantiteMatiere;
+        mesures.litres += sign * record.quantiteProduite;
+        if (record.rendement > 0.0) {
+            mesures.rendementTotal += sign * record.rendement;
+            mesures.rendementCount += sign;
+        }
+        if (mesures.count <= 0)
+            m_cells.remove(key);
+    }
+
+    adjustMember(m_types, point.type, sign);
+    adjustMember(m_mois, point.mois, sign);
+    adjustMember(m_qualites, point.qualite, sign);
+}
+
+QVector<ProductionCube::Member> ProductionCube::drillDown(const Slice &slice, Dimension dimension) const
+{
+    QVector<Member> members;
+    auto collect = [&](const Slice &child, const QString &libelle) {
+        auto it = m_cells.constFind(cellKey(child));
+        if (it != m_cells.constEnd())
+            members.append(Member{child, libelle, it.value()});
+    };
+
+    switch (dimension) {
+    case DimType:
+        for (auto it = m_types.constBegin(); it != m_types.constEnd(); ++it) {
+            Slice child = slice;
+            child.type = it.key();
+            collect(child, it.key());
+        }
+        break;
+    case DimMois:
+        for (auto it = m_mois.constBegin(); it != m_mois.constEnd(); ++it) {
+            Slice child = slice;
+            child.mois = it.key();
+            collect(child, moisLibelle(it.key()));
+        }
+        break;
+    case DimQualite:
+        for (auto it = m_qualites.constBegin(); it != m_qualites.constEnd(); ++it) {
+            Slice child = slice;
+            child.qualite = it.key();
+            collect(child, it.key());
+        }
+        break;
+    }
+    return members;
+}
+
+// =======================
+// ProductionTimeSeries
+// =======================
+// Somme d'une plage contiguë : deux accumulateurs SSE2 de deux doubles,
+// boucle scalaire pour la fin de plage ou sans SSE2
+static double sumRange(const double *values, int count)
+{
+    int i = 0;
+    double total = 0.0;
+#ifdef MAINWINDOW_HAS_SSE2
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(values + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(values + i + 2));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    total = lanes[0] + lanes[1];
+#endif
+    for (; i < count; ++i)
+        total += values[i];
+    return total;
+}
+
+QDate ProductionTimeSeries::bucketStart(Granularity granularity, const QDate &date)
+{
+    switch (granularity) {
+    case Semaine:
+        return date.addDays(1 - date.dayOfWeek());
+    case Mois:
+        return QDate(date.year(), date.month(), 1);
+    default:
+        return date;
+    }
+}
+
+int ProductionTimeSeries::bucketOffset(Granularity granularity, const QDate &origin, const QDate &date)
+{
+    switch (granularity) {
+    case Semaine:
+        return int(origin.daysTo(bucketStart(Semaine, date)) / 7);
+    case Mois:
+        return (date.year() - origin.year()) * 12 + (date.month() - origin.month());
+    default:
+        return int(origin.daysTo(date));
+    }
+}
+
+QDate ProductionTimeSeries::bucketDate(Granularity granularity, const QDate &origin, int index)
+{
+    switch (granularity) {
+    case Semaine:
+        return origin.addDays(7 * index);
+    case Mois:
+        return origin.addMonths(index);
+    default:
+        return origin.addDays(index);
+    }
+}
+
+void ProductionTimeSeries::apply(const QDate &date, double kg, double litres)
+{
+    if (!date.isValid())
+        return;
+
+    for (int g = Jour; g <= Mois; ++g) {
+        const Granularity granularity = Granularity(g);
+        Buckets &buckets = m_buckets[g];
+        const QDate start = bucketStart(granularity, date);
+
+        if (!buckets.origin.isValid()) {
+            buckets.origin = start;
+        } else if (start < buckets.origin) {
+            // Date antérieure à l'origine : on décale l'origine vers le passé
+            const int shift = bucketOffset(granularity, start, buckets.origin);
+            buckets.kg.insert(0, shift, 0.0);
+            buckets.litres.insert(0, shift, 0.0);
+            buckets.origin = start;
+        }
+
+        const int index = bucketOffset(granularity, buckets.origin, date);
+        if (index >= buckets.kg.size()) {
+            buckets.kg.resize(index + 1);
+            buckets.litres.resize(index + 1);
+        }
+        buckets.kg[index] += kg;
+        buckets.litres[index] += litres;
+    }
+}
+
+void ProductionTimeSeries::rebuild(const ProductionStore &store)
+{
+    for (Buckets &buckets : m_buckets)
+        buckets = Buckets();
+
+    // Colonnes brutes triées par jour : chaque jour devient une plage contiguë
+    QVector<qint64> jours;
+    QVector<double> kg;
+    QVector<double> litres;
+    jours.reserve(store.size());
+    kg.reserve(store.size());
+    litres.reserve(store.size());
+    for (const ProductionRecord &record : store.records()) {
+        if (!record.dateProduction.isValid())
+            continue;
+        jours.append(record.dateProduction.toJulianDay());
+        kg.append(record.quantiteMatiere);
+        litres.append(record.quantiteProduite);
+    }
+    if (jours.isEmpty())
+        return;
+
+    QVector<int> order(jours.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return jours[a] < jours[b]; });
+
+    QVector<double> kgTries(order.size());
+    QVector<double> litresTries(order.size());
+    for (int i = 0; i < order.size(); ++i) {
+        kgTries[i] = kg[order[i]];
+        litresTries[i] = litres[order[i]];
+    }
+
+    Buckets &days = m_buckets[Jour];
+    const qint64 premier = jours[order.first()];
+    days.origin = QDate::fromJulianDay(premier);
+    days.kg.resize(int(jours[order.last()] - premier) + 1);
+    days.litres.resize(days.kg.size());
+
+    for (int begin = 0; begin < order.size();) {
+        const qint64 jour = jours[order[begin]];
+        int end = begin + 1;
+        while (end < order.size() && jours[order[end]] == jour)
+            ++end;
+        const int index = int(jour - premier);
+        days.kg[index] = sumRange(kgTries.constData() + begin, end - begin);
+        days.litres[index] = sumRange(litresTries.constData() + begin, end - begin);
+        begin = end;
+    }
+
+    rollUpFromDays(Semaine);
+    rollUpFromDays(Mois);
+}
+
+void ProductionTimeSeries::rollUpFromDays(Granularity granularity)
+{
+    // Une semaine ou un mois est une plage contiguë de seaux journaliers
+    const Buckets &days = m_buckets[Jour];
+    Buckets &buckets = m_buckets[granularity];
+    const QDate dernierJour = days.origin.addDays(days.kg.size() - 1);
+
+    buckets.origin = bucketStart(granularity, days.origin);
+    const int count = bucketOffset(granularity, buckets.origin, dernierJour) + 1;
+    buckets.kg.resize(count);
+    buckets.litres.resize(count);
+
+    for (int index = 0; index < count; ++index) {
+        const QDate debut = bucketDate(granularity, buckets.origin, index);
+        const QDate fin = bucketDate(granularity, buckets.origin, index + 1);
+        const int first = qMax(0, int(days.origin.daysTo(debut)));
+        const int last = qMin(int(days.kg.size()), int(days.origin.daysTo(fin)));
+        if (last <= first)
+            continue;
+        buckets.kg[index] = sumRange(days.kg.constData() + first, last - first);
+        buckets.litres[index] = sumRange(days.litres.constData() + first, last - first);
+    }
+}
+
+QVector<ProductionTimeSeries::Point> ProductionTimeSeries::series(Granularity granularity) const
+{
+    const Buckets &buckets = m_buckets[granularity];
+    QVector<Point> points;
+    points.reserve(buckets.kg.size());
+    for (int index = 0; index < buckets.kg.size(); ++index)
+        points.append(Point{bucketDate(granularity, buckets.origin, index), buckets.kg[index], buckets.litres[index]});
+    return points;
+}
+
+// =======================
+// YieldAnalytics
+// =======================
+void YieldAnalytics::Moments::add(double x)
+{
+    ++n;
+    const double delta = x - mean;
+    mean += delta / n;
+    m2 += delta * (x - mean);
+}
+
+void YieldAnalytics::Moments::remove(double x)
+{
+    if (n <= 1) {
+        *this = Moments();
+        return;
+    }
+    const double meanBefore = mean;
+    mean = (n * mean - x) / (n - 1);
+    m2 = qMax(0.0, m2 - (x - meanBefore) * (x - mean));
+    --n;
+}
+
+double YieldAnalytics::Moments::stddev() const
+{
+    return n > 1 ? std::sqrt(m2 / (n - 1)) : 0.0;
+}
+
+int YieldAnalytics::classeDe(double rendement)
+{
+    return qBound(0, int(rendement / LargeurClasse), NombreClasses - 1);
+}
+
+void YieldAnalytics::apply(const ProductionRecord &record, int sign)
+{
+    // Pas de rendement pour les olives
+    if (record.rendement <= 0.0)
+        return;
+
+    const int centi = qRound(record.rendement * 100.0);
+    m_histogram[classeDe(record.rendement)] += sign;
+
+    Distribution &distribution = m_types[record.typeProduit];
+    QMap<int, Moments> &parMois = m_groupes[record.typeProduit];
+    Moments &mois = parMois[ProductionCube::moisCle(record.dateProduction)];
+
+    if (sign > 0) {
+        distribution.valeurs[centi].append(record.id);
+        distribution.moments.add(record.rendement);
+        mois.add(record.rendement);
+    } else {
+        auto it = distribution.valeurs.find(centi);
+        if (it != distribution.valeurs.end()) {
+            it->removeOne(record.id);
+            if (it->isEmpty())
+                distribution.valeurs.erase(it);
+        }
+        distribution.moments.remove(record.rendement);
+        mois.remove(record.rendement);
+        if (mois.n == 0)
+            parMois.remove(ProductionCube::moisCle(record.dateProduction));
+    }
+
+    if (distribution.moments.n == 0) {
+        m_types.remove(record.typeProduit);
+        m_groupes.remove(record.typeProduit);
+        return;
+    }
+    refreshRobust(distribution);
+}
+
+void YieldAnalytics::refreshRobust(Distribution &distribution)
+{
+    // Médiane basse : parcours cumulé des valeurs distinctes
+    const int rank = (distribution.moments.n + 1) / 2;
+    auto median = distribution.valeurs.constBegin();
+    int cumulative = 0;
+    for (; median != distribution.valeurs.constEnd(); ++median) {
+        cumulative += median->size();
+        if (cumulative >= rank)
+            break;
+    }
+    distribution.medianeCenti = median.key();
+
+    // MAD : les écarts à la médiane croissent en s'éloignant des deux côtés,
+    // on fusionne les deux parcours jusqu'au même rang
+    auto left = median;
+    auto right = std::next(median);
+    bool leftValid = true;
+    int taken = 0;
+    int ecart = 0;
+    while (taken < rank) {
+        const int ecartGauche = leftValid ? distribution.medianeCenti - left.key() : INT_MAX;
+        const int ecartDroit = right != distribution.valeurs.constEnd() ? right.key() - distribution.medianeCenti : INT_MAX;
+        if (ecartGauche <= ecartDroit) {
+            taken += left->size();
+            ecart = ecartGauche;
+            if (left == distribution.valeurs.constBegin())
+                leftValid = false;
+            else
+                --left;
+        } else {
+            taken += right->size();
+            ecart = ecartDroit;
+            ++right;
+        }
+    }
+    distribution.madCenti = ecart;
+}
+
+QVector<YieldAnalytics::GroupStats> YieldAnalytics::groups() const
+{
+    QVector<GroupStats> groups;
+    for (auto type = m_groupes.constBegin(); type != m_groupes.constEnd(); ++type) {
+        groups.append(GroupStats{type.key(), 0, m_types.value(type.key()).moments});
+        for (auto mois = type->constBegin(); mois != type->constEnd(); ++mois)
+            groups.append(GroupStats{type.key(), mois.key(), mois.value()});
+    }
+    return groups;
+}
+
+QVector<YieldAnalytics::Outlier> YieldAnalytics::outliers() const
+{
+    // z robuste = 0,6745 (x - médiane) / MAD ; seules les extrémités peuvent
+    // dépasser le seuil, on s'arrête à la première valeur sous le seuil
+    QVector<Outlier> outliers;
+    for (auto type = m_types.constBegin(); type != m_types.constEnd(); ++type) {
+        const Distribution &distribution = type.value();
+        if (distribution.madCenti == 0)
+            continue;
+
+        auto zScore = [&](int centi) {
+            return 0.6745 * (centi - distribution.medianeCenti) / distribution.madCenti;
+        };
+        auto collect = [&](QMap<int, QVector<quint64>>::const_iterator it) {
+            for (quint64 id : it.value())
+                outliers.append(Outlier{id, type.key(), it.key() / 100.0, zScore(it.key())});
+        };
+
+        for (auto it = distribution.valeurs.constBegin(); it != distribution.valeurs.constEnd() && zScore(it.key()) < -SeuilZ; ++it)
+            collect(it);
+        for (auto it = distribution.valeurs.constEnd(); it != distribution.valeurs.constBegin();) {
+            --it;
+            if (zScore(it.key()) <= SeuilZ)
+                break;
+            collect(it);
+        }
+    }
+    return outliers;
+}
+
+// =======================
+// AnalyticsExecutor
+// =======================
+namespace {
+
+class AnalyticsTask : public QRunnable
+{
+public:
+    AnalyticsTask(AnalyticsExecutor *executor, const QString &key, quint64 generation,
+                  const StoreSnapshot &snapshot, const AnalyticsExecutor::Job &job,
+                  const std::shared_ptr<std::atomic_bool> &cancelled)
+        : m_executor(executor)
+        , m_key(key)
+        , m_generation(generation)
+        , m_snapshot(snapshot)
+        , m_job(job)
+        , m_cancelled(cancelled)
+    {
+    }
+
+    void run() override
+    {
+        if (*m_cancelled)
+            return;
+        const AnalyticsExecutor::Publisher publisher = m_job(m_snapshot, *m_cancelled);
+        if (*m_cancelled || !publisher)
+            return;
+        // Émis depuis le thread du pool : livré en file d'attente au thread graphique
+        emit m_executor->jobFinished(m_key, m_generation, publisher);
+    }
+
+private:
+    AnalyticsExecutor *m_executor;
+    QString m_key;
+    quint64 m_generation;
+    StoreSnapshot m_snapshot;
+    AnalyticsExecutor::Job m_job;
+    std::shared_ptr<std::atomic_bool> m_cancelled;
+};
+
+} // namespace
+
+AnalyticsExecutor::AnalyticsExecutor(QObject *parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<AnalyticsExecutor::Publisher>("AnalyticsExecutor::Publisher");
+    connect(this, &AnalyticsExecutor::jobFinished, this, &AnalyticsExecutor::deliver, Qt::QueuedConnection);
+}
+
+AnalyticsExecutor::~AnalyticsExecutor()
+{
+    cancelAll();
+    m_pool.waitForDone();
+}
+
+void AnalyticsExecutor::submit(const QString &key, const StoreSnapshot &snapshot, const Job &job)
+{
+    // La tâche précédente de même clé est dépassée : elle s'arrête au prochain point de contrôle
+    Pending &pending = m_pending[key];
+    if (pending.cancelled)
+        *pending.cancelled = true;
+
+    pending.generation = ++m_nextGeneration;
+    pending.cancelled = std::make_shared<std::atomic_bool>(false);
+    m_pool.start(new AnalyticsTask(this, key, pending.generation, snapshot, job, pending.cancelled));
+}
+
+void AnalyticsExecutor::cancelAll()
+{
+    for (const Pending &pending : std::as_const(m_pending)) {
+        if (pending.cancelled)
+            *pending.cancelled = true;
+    }
+    m_pending.clear();
+}
+
+void AnalyticsExecutor::deliver(const QString &key, quint64 generation, const AnalyticsExecutor::Publisher &publisher)
+{
+    auto it = m_pending.find(key);
+    if (it == m_pending.end() || it->generation != generation)
+        return;
+    m_pending.erase(it);
+    publisher();
+}
+
+// =======================
+// ReportQueue
+// =======================
+namespace {
+
+class ReportTask : public QRunnable
+{
+public:
+    ReportTask(ReportQueue *queue, int id, const ReportQueue::Task &task,
+               const std::shared_ptr<std::atomic_bool> &cancelled)
+        : m_queue(queue)
+        , m_id(id)
+        , m_task(task)
+        , m_cancelled(cancelled)
+    {
+    }
+
+    void run() override
+    {
+        int outcome = ReportQueue::Cancelled;
+        ReportQueue::Control control(m_queue, m_id, m_cancelled);
+        if (!*m_cancelled) {
+            const bool ok = m_task(control);
+            if (!*m_cancelled)
+                outcome = ok ? ReportQueue::Generated : ReportQueue::Failed;
+        }
+        emit m_queue->finished(m_id, outcome, control.summary());
+    }
+
+private:
+    ReportQueue *m_queue;
+    int m_id;
+    ReportQueue::Task m_task;
+    std::shared_ptr<std::atomic_bool> m_cancelled;
+};
+
+// Document HTML : mise en page et impression se font sur le thread du rapport
+ReportQueue::Job rapportHtml(const QString &html)
+{
+    return [html](QPrinter &printer, ReportQueue::Control &control) {
+        QTextDocument doc;
+        doc.setHtml(html);
+        control.setProgress(50);
+        if (control.cancelled())
+            return false;
+        doc.print(&printer);
+        control.setProgress(100);
+        return printer.printerState() != QPrinter::Error;
+    };
+}
+
+// Facture d'une commande ; les cellules suivent l'ordre des colonnes des
+// tables de commandes (voir MainWindow::setupModels())
+QString factureHtml(const QString &titre, const QString &libelle, const QStringList &cellules)
+{
+    QString html = "<html><head><style>"
+                   "body { font-family: Arial; margin: 40px; }"
+                   "h1 { color: #556b2f; text-align: center; }"
+                   "table { width: 100%; border-collapse: collapse; margin-top: 20px; }"
+                   "td, th { border: 1px solid #ddd; padding: 12px; text-align: left; }"
+                   "th { background-color: #f0f0f0; font-weight: bold; }"
+                   ".total { font-size: 18px; font-weight: bold; color: #556b2f; }"
+                   "</style></head><body>";
+
+    html += "<h1>" + titre + "</h1>";
+    html += "<p><b>Date:</b> " + QDate::currentDate().toString("dd/MM/yyyy") + "</p>";
+    html += "<p><b>ID Commande:</b> " + cellules.value(0) + "</p>";
+
+    html += "<table>";
+    html += "<tr><th>" + libelle + "</th><td>" + cellules.value(1) + "</td></tr>";
+    html += "<tr><th>Email</th><td>" + cellules.value(2) + "</td></tr>";
+    html += "<tr><th>Téléphone</th><td>" + cellules.value(3) + "</td></tr>";
+    html += "<tr><th>Produit</th><td>" + cellules.value(4) + "</td></tr>";
+    html += "<tr><th>Date commande</th><td>" + cellules.value(5) + "</td></tr>";
+    html += "<tr><th>Date livraison</th><td>" + cellules.value(6) + "</td></tr>";
+    html += "<tr><th>Prix HT</th><td>" + cellules.value(7) + " DT</td></tr>";
+    html += "<tr><th>TVA</th><td>19%</td></tr>";
+    html += "<tr><th class='total'>Prix TTC</th><td class='total'>" + cellules.value(11) + " DT</td></tr>";
+    html += "<tr><th>Mode de paiement</th><td>" + cellules.value(8) + "</td></tr>";
+    html += "<tr><th>Statut</th><td>" + cellules.value(9) + "</td></tr>";
+    html += "</table>";
+
+    html += "</body></html>";
+    return html;
+}
+
+class FunctionTask : public QRunnable
+{
+public:
+    explicit FunctionTask(std::function<void()> function) : m_function(std::move(function)) {}
+    void run() override { m_function(); }
+
+private:
+    std::function<void()> m_function;
+};
+
+// Lot de factures figé au moment de la demande
+struct LotFactures
+{
+    OrderStore store;
+    QVector<quint64> ids;                       // commandes retenues, ordre de la table
+    QVector<OrderTableModel::Column> colonnes;
+    QString titre;
+    QString libelle;
+    QString destination;                        // dossier, ou fichier si fusion
+    bool fusion = false;
+};
+
+// Rendu d'un lot sur tous les cœurs : chaque fil prend la facture suivante
+// dans un compteur partagé. Sans fusion, chaque facture est imprimée dans
+// son propre fichier ; avec fusion, chaque facture est mise en page dans un
+// QPicture, puis les pages sont reproduites dans l'ordre dans un seul PDF.
+ReportQueue::Task rapportFactures(const LotFactures &lot)
+{
+    return [lot](ReportQueue::Control &control) {
+        QElapsedTimer chrono;
+        chrono.start();
+
+        const int total = lot.ids.size();
+        std::atomic_int suivante(0);
+        std::atomic_int rendues(0);
+        std::atomic_bool echec(false);
+
+        // Chaque fil n'écrit que dans ses propres cases
+        QVector<QPicture> pages(lot.fusion ? total : 0);
+        QPicture *page = pages.data();
+        QVector<char> ecrites(lot.fusion ? 0 : total, 0);
+        char *ecrite = ecrites.data();
+        auto fichier = [&lot](const QString &idCommande) {
+            return QDir(lot.destination).filePath("Facture_" + idCommande + ".pdf");
+        };
+
+        // Géométrie de la page fusionnée, comme QTextDocument::print() :
+        // zone imprimable de l'imprimante et marges de 2 cm
+        QPrinter printer(QPrinter::HighResolution);
+        printer.setOutputFormat(QPrinter::PdfFormat);
+        if (lot.fusion)
+            printer.setOutputFileName(lot.destination);
+        printer.setPageSize(QPageSize(QPageSize::A4));
+        const qreal dpiPage = QPicture().logicalDpiY();
+        const qreal echelle = printer.resolution() / dpiPage;
+        const QSizeF taille(printer.width() / echelle, printer.height() / echelle);
+
+        auto travail = [&]() {
+            for (int i = suivante++; i < total && !control.cancelled() && !echec; i = suivante++) {
+                const OrderRecord *record = lot.store.find(lot.ids[i]);
+                if (record) {
+                    QStringList cellules;
+                    for (const OrderTableModel::Column &colonne : lot.colonnes)
+                        cellules.append(colonne.texte(*record));
+
+                    QTextDocument doc;
+                    doc.setHtml(factureHtml(lot.titre, lot.libelle, cellules));
+                    if (lot.fusion) {
+                        QTextFrameFormat cadre = doc.rootFrame()->frameFormat();
+                        cadre.setMargin(2.0 / 2.54 * dpiPage);
+                        doc.rootFrame()->setFrameFormat(cadre);
+                        doc.setPageSize(taille);
+                        QPainter painter(&page[i]);
+                        doc.drawContents(&painter, QRectF(QPointF(0, 0), taille));
+                    } else {
+                        QPrinter sortie(QPrinter::HighResolution);
+                        sortie.setOutputFormat(QPrinter::PdfFormat);
+                        sortie.setOutputFileName(fichier(cellules.value(0)));
+                        sortie.setPageSize(QPageSize(QPageSize::A4));
+                        doc.print(&sortie);
+                        ecrite[i] = 1;
+                        if (sortie.printerState() == QPrinter::Error)
+                            echec = true;
+                    }
+                }
+                ++rendues;
+            }
+        };
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+        for (int t = 0; t < pool.maxThreadCount(); ++t)
+            pool.start(new FunctionTask(travail));
+
+        // Ce fil ne fait que suivre l'avancement pendant le rendu
+        const int partRendu = lot.fusion ? 80 : 100;
+        while (!pool.waitForDone(100))
+            control.setProgress(partRendu * rendues / total);
+
+        if (control.cancelled()) {
+            for (int i = 0; i < ecrites.size(); ++i) {
+                if (ecrites[i])
+                    QFile::remove(fichier(lot.colonnes[0].texte(*lot.store.find(lot.ids[i]))));
+            }
+            return false;
+        }
+        if (echec)
+            return false;
+
+        if (lot.fusion) {
+            QPainter painter;
+            if (!painter.begin(&printer))
+                return false;
+            bool premiere = true;
+            for (int i = 0; i < total; ++i) {
+                if (control.cancelled()) {
+                    painter.end();
+                    QFile::remove(lot.destination);
+                    return false;
+                }
+                if (pages[i].isNull())
+                    continue;
+                if (!premiere)
+                    printer.newPage();
+                premiere = false;
+                painter.save();
+                painter.scale(echelle, echelle);
+                painter.drawPicture(0, 0, pages[i]);
+                painter.restore();
+                control.setProgress(partRendu + (100 - partRendu) * (i + 1) / total);
+            }
+            painter.end();
+            if (printer.printerState() == QPrinter::Error)
+                return false;
+        }
+
+        const double secondes = chrono.nsecsElapsed() / 1e9;
+        control.setSummary(QString("%1 factures exportées en %2 s (%3 factures/s).")
+                               .arg(total)
+                               .arg(secondes, 0, 'f', 2)
+                               .arg(total / qMax(secondes, 1e-9), 0, 'f', 1));
+        return true;
+    };
+}
+
+} // namespace
+
+ReportQueue::Control::Control(ReportQueue *queue, int id, const std::shared_ptr<std::atomic_bool> &cancelled)
+    : m_queue(queue), m_id(id), m_cancelled(cancelled)
+{
+}
+
+void ReportQueue::Control::setProgress(int percent)
+{
+    // Un signal par point de pourcentage au plus
+    percent = qBound(0, percent, 100);
+    if (percent == m_percent)
+        return;
+    m_percent = percent;
+    emit m_queue->progressed(m_id, percent);
+}
+
+ReportQueue::ReportQueue(QObject *parent)
+    : QObject(parent)
+{
+    m_pool.setMaxThreadCount(2);
+    connect(this, &ReportQueue::progressed, this, &ReportQueue::onProgressed, Qt::QueuedConnection);
+    connect(this, &ReportQueue::finished, this, &ReportQueue::onFinished, Qt::QueuedConnection);
+}
+
+ReportQueue::~ReportQueue()
+{
+    for (const Entry &entry : std::as_const(m_entries))
+        *entry.cancelled = true;
+    m_pool.waitForDone();
+}
+
+int ReportQueue::submit(const QString &titre, const QString &fileName, const Job &job)
+{
+    return submitTask(titre, fileName, [fileName, job](Control &control) {
+        bool ok = false;
+        {
+            QPrinter printer(QPrinter::HighResolution);
+            printer.setOutputFormat(QPrinter::PdfFormat);
+            printer.setOutputFileName(fileName);
+            printer.setPageSize(QPageSize(QPageSize::A4));
+            ok = job(printer, control);
+        }
+        // L'imprimante est détruite : le fichier est fermé et peut être retiré
+        if (control.cancelled())
+            QFile::remove(fileName);
+        return ok;
+    });
+}
+
+int ReportQueue::submitTask(const QString &titre, const QString &path, const Task &task)
+{
+    const int id = ++m_nextId;
+    Entry &entry = m_entries[id];
+    entry.titre = titre;
+    entry.path = path;
+    entry.cancelled = std::make_shared<std::atomic_bool>(false);
+    m_pool.start(new ReportTask(this, id, task, entry.cancelled));
+    emit changed();
+    return id;
+}
+
+void ReportQueue::cancel(int id)
+{
+    // Le rendu s'arrête à son prochain point de contrôle ; l'entrée reste
+    // dans la file jusqu'au signal de fin
+    auto it = m_entries.find(id);
+    if (it != m_entries.end())
+        *it->cancelled = true;
+}
+
+void ReportQueue::onProgressed(int id, int percent)
+{
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return;
+    it->percent = percent;
+    emit changed();
+}
+
+void ReportQueue::onFinished(int id, int outcome, const QString &resume)
+{
+    auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return;
+    const QString path = it->path;
+    m_entries.erase(it);
+    emit changed();
+    emit reportFinished(path, Outcome(outcome), resume);
+}
+
+// =======================
+// AnimationTicker
+// =======================
+
+// Horloge partagée par toutes les animations : un seul timer pour toute
+// l'application, actif uniquement tant qu'un abonné est visible. La période
+// est un multiple de celle de l'écran (~30 ms) pour rester calée sur le
+// rafraîchissement.
+class AnimationTicker : public QObject
 {
-    Q_UNUSED(event);
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
+    Q_OBJECT
 
-    if (m_total == 0 || m_data.isEmpty()) {
-        painter.setPen(QColor(74, 106, 42));
-        painter.setFont(QFont("Arial", 11, QFont::Bold));
-        painter.drawText(rect(), Qt::AlignCenter, "Aucune production enregistrée.");
-        return;
+public:
+    static AnimationTicker *instance()
+    {
+        static QPointer<AnimationTicker> ticker;
+        if (!ticker)
+            ticker = new AnimationTicker(qApp);
+        return ticker;
     }
 
-    QRect chartRect = rect();
-    int margin = 10;
-    int legendWidth = 160;
-    int legendItemHeight = 24;
-    int maxChartSize = qMin(chartRect.width() - legendWidth - margin * 3,
-                            chartRect.height() - margin * 2 - 30);
-    int chartX = margin;
-    int chartY = margin;
-    int chartSize = maxChartSize;
-    int legendStartY = chartY;
-    QRect pieRect(chartX, chartY, chartSize, chartSize);
-
-    double startAngle = 0;
-    int colorIndex = 0;
-    int dataIndex = 0;
-
-    for (auto it = m_data.begin(); it != m_data.end(); ++it) {
-        double percentage = (it.value() * 360.0) / m_total;
-        double spanAngle = percentage;
-        QColor color = m_colors[colorIndex % m_colors.size()];
-        painter.setBrush(color);
-        painter.setPen(QPen(QColor(255, 255, 255), 2));
-        painter.drawPie(pieRect, static_cast<int>(startAngle * 16), static_cast<int>(spanAngle * 16));
+    void subscribe(QObject *client)
+    {
+        if (m_clients.contains(client))
+            return;
+        m_clients.insert(client);
+        if (!m_timer.isActive()) {
+            m_timer.setInterval(frameInterval());
+            m_clock.start();
+            m_timer.start();
+        }
+    }
 
-        int legendX = chartX + chartSize + margin;
-        int legendY = legendStartY + dataIndex * legendItemHeight;
-        QRect colorBox(legendX, legendY, 15, 15);
-        painter.setBrush(color);
-        painter.setPen(QPen(QColor(200, 200, 200), 1));
-        painter.drawRect(colorBox);
+    void unsubscribe(QObject *client)
+    {
+        m_clients.remove(client);
+        if (m_clients.isEmpty())
+            m_timer.stop();
+    }
 
-        painter.setPen(QColor(26, 48, 9));
-        painter.setFont(QFont("Arial", 10, QFont::Bold));
-        QString label = QString("%1 (%2%)")
-                           .arg(it.key())
-                           .arg(QString::number((it.value() * 100.0) / m_total, 'f', 1));
-        painter.drawText(legendX + 20, legendY + 12, label);
+signals:
+    // Temps écoulé depuis la trame précédente, en millisecondes
+    void frame(qreal elapsedMs);
 
-        startAngle += spanAngle;
-        colorIndex++;
-        dataIndex++;
+private:
+    explicit AnimationTicker(QObject *parent) : QObject(parent)
+    {
+        m_timer.setTimerType(Qt::PreciseTimer);
+        connect(&m_timer, &QTimer::timeout, this, [this]() {
+            emit frame(qreal(m_clock.restart()));
+        });
     }
 
-    painter.setPen(QColor(74, 106, 42));
-    painter.setFont(QFont("Arial", 11, QFont::Bold));
-    QString totalText = QString("Total: %1 production%2").arg(m_total).arg(m_total > 1 ? "s" : "");
-    QFontMetrics fm(painter.font());
-    int textWidth = fm.horizontalAdvance(totalText);
-    int textY = chartY + chartSize + 20;
-    if (textY < chartRect.height() - 5) {
-        painter.drawText((chartRect.width() - textWidth) / 2, textY, totalText);
+    static int frameInterval()
+    {
+        const int cible = 30;
+        QScreen *screen = QGuiApplication::primaryScreen();
+        const qreal hz = screen ? screen->refreshRate() : 60.0;
+        const qreal periode = 1000.0 / (hz > 1.0 ? hz : 60.0);
+        const int trames = qMax(1, qRound(cible / periode));
+        return qMax(1, qRound(trames * periode));
     }
-}
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    QSet<QObject *> m_clients;
+};
 
 // =======================
 // AnimatedBackgroundWidget
@@ -147,21 +2621,30 @@ public:
         setAttribute(Qt::WA_NoSystemBackground, false);
         setAutoFillBackground(false);
 
-        timer = new QTimer(this);
-        connect(timer, &QTimer::timeout, this, QOverload<>::of(&AnimatedBackgroundWidget::update));
-        timer->start(30);
+        // Suit la taille du parent sans interrogation périodique
+        if (parent)
+            parent->installEventFilter(this);
+    }
+
+    ~AnimatedBackgroundWidget() override
+    {
+        AnimationTicker::instance()->unsubscribe(this);
     }
 
     void initializeOlives(int w, int h)
     {
         olives.clear();
         for (int i = 0; i < 15; ++i) {
-            olives.append({
+            Olive olive{
                 QPointF(rand() % qMax(1, w), rand() % qMax(1, h)),
                 QPointF((rand() % 200 - 100) / 50.0, (rand() % 200 - 100) / 50.0),
                 (rand() % 30 + 20) / 10.0,
-                QColor(85 + rand() % 30, 107 + rand() % 30, 47 + rand() % 20)
-            });
+                QColor(85 + rand() % 30, 107 + rand() % 30, 47 + rand() % 20),
+                QPixmap(),
+                QPointF()
+            };
+            renderSprite(olive);
+            olives.append(olive);
         }
     }
 
@@ -169,21 +2652,115 @@ protected:
     void paintEvent(QPaintEvent *event) override
     {
         Q_UNUSED(event);
+
+        const qreal dpr = devicePixelRatioF();
+        if (background.size() != size() * dpr || !qFuzzyCompare(background.devicePixelRatio(), dpr))
+            renderBackground(dpr);
+
+        // Chaque trame se résume à quelques copies de pixmaps
         QPainter painter(this);
-        painter.setRenderHint(QPainter::Antialiasing);
+        painter.drawPixmap(0, 0, background);
+        for (const Olive &olive : olives)
+            painter.drawPixmap(olive.pos + olive.spriteOffset, olive.sprite);
+    }
 
+    void resizeEvent(QResizeEvent *event) override
+    {
+        QWidget::resizeEvent(event);
         int w = width();
         int h = height();
+        for (auto &olive : olives) {
+            if (olive.pos.x() > w) olive.pos.setX(w - 50);
+            if (olive.pos.y() > h) olive.pos.setY(h - 50);
+            if (olive.pos.x() < 0) olive.pos.setX(50);
+            if (olive.pos.y() < 0) olive.pos.setY(50);
+        }
+    }
 
-        QLinearGradient gradient(0, 0, w, h);
-        gradient.setColorAt(0, QColor(85, 107, 47));
-        gradient.setColorAt(0.3, QColor(107, 142, 35));
-        gradient.setColorAt(0.6, QColor(128, 128, 0));
-        gradient.setColorAt(1, QColor(85, 107, 47));
-        painter.fillRect(rect(), gradient);
+    void showEvent(QShowEvent *event) override
+    {
+        QWidget::showEvent(event);
+        if (parentWidget()) {
+            int w = parentWidget()->width();
+            int h = parentWidget()->height();
+            setGeometry(0, 0, w, h);
+            if (olives.isEmpty()) {
+                initializeOlives(w, h);
+            }
+        }
+
+        // L'exposition de la fenêtre native (réduite ou recouverte par une
+        // autre fenêtre, selon la plateforme) décide de l'abonnement
+        QWindow *fenetre = window()->windowHandle();
+        if (fenetre != nativeWindow) {
+            if (nativeWindow)
+                nativeWindow->removeEventFilter(this);
+            nativeWindow = fenetre;
+            if (nativeWindow)
+                nativeWindow->installEventFilter(this);
+        }
+        updateSubscription();
+    }
+
+    // Page quittée : plus aucune trame n'est produite
+    void hideEvent(QHideEvent *event) override
+    {
+        QWidget::hideEvent(event);
+        updateSubscription();
+    }
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (watched == nativeWindow && event->type() == QEvent::Expose)
+            updateSubscription();
+        if (watched == parentWidget() && event->type() == QEvent::Resize) {
+            const int w = parentWidget()->width();
+            const int h = parentWidget()->height();
+            if (width() != w || height() != h) {
+                setGeometry(0, 0, w, h);
+                if (w > 0 && h > 0)
+                    initializeOlives(w, h);
+            }
+        }
+        return QWidget::eventFilter(watched, event);
+    }
+
+private:
+    struct Olive {
+        QPointF pos;
+        QPointF velocity;
+        double size;
+        QColor color;
+        QPixmap sprite;
+        QPointF spriteOffset;
+    };
+
+    // Abonné à l'horloge seulement tant que le fond est visible dans une
+    // fenêtre exposée : réduite ou masquée, elle ne coûte aucun réveil
+    void updateSubscription()
+    {
+        const bool expose = isVisible() && nativeWindow && nativeWindow->isExposed();
+        if (expose == bool(frameConnection))
+            return;
+        if (expose) {
+            frameConnection = connect(AnimationTicker::instance(), &AnimationTicker::frame,
+                                      this, &AnimatedBackgroundWidget::advanceFrame);
+            AnimationTicker::instance()->subscribe(this);
+        } else {
+            disconnect(frameConnection);
+            frameConnection = QMetaObject::Connection();
+            AnimationTicker::instance()->unsubscribe(this);
+        }
+    }
 
+    void advanceFrame(qreal elapsedMs)
+    {
+        // Vitesses exprimées par pas de 30 ms ; un saut après une reprise est borné
+        const double pas = qMin(elapsedMs, 100.0) / 30.0;
+        const int w = width();
+        const int h = height();
         for (auto &olive : olives) {
-            olive.pos += olive.velocity;
+            olive.pos += olive.velocity * pas;
 
             if (olive.pos.x() < 0 || olive.pos.x() > w) {
                 olive.velocity.setX(-olive.velocity.x());
@@ -194,60 +2771,491 @@ protected:
 
             olive.pos.setX(qBound(0.0, olive.pos.x(), double(w)));
             olive.pos.setY(qBound(0.0, olive.pos.y(), double(h)));
+        }
+        update();
+    }
+
+    void renderBackground(qreal dpr)
+    {
+        background = QPixmap(size() * dpr);
+        background.setDevicePixelRatio(dpr);
+
+        QPainter painter(&background);
+        QLinearGradient gradient(0, 0, width(), height());
+        gradient.setColorAt(0, QColor(85, 107, 47));
+        gradient.setColorAt(0.3, QColor(107, 142, 35));
+        gradient.setColorAt(0.6, QColor(128, 128, 0));
+        gradient.setColorAt(1, QColor(85, 107, 47));
+        painter.fillRect(rect(), gradient);
+    }
+
+    void renderSprite(Olive &olive) const
+    {
+        const qreal dpr = devicePixelRatioF();
+        const int size = int(olive.size * 15);
+        const int bord = 2;
+        const QSizeF taille(size + bord * 2, size * 1.3 + bord * 2);
+
+        olive.sprite = QPixmap((taille * dpr).toSize() + QSize(1, 1));
+        olive.sprite.setDevicePixelRatio(dpr);
+        olive.sprite.fill(Qt::transparent);
+        olive.spriteOffset = QPointF(-size / 2 - bord, -size / 2 - bord);
+
+        QPainter painter(&olive.sprite);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setBrush(QBrush(olive.color));
+        painter.setPen(QPen(QColor(olive.color.red() - 20, olive.color.green() - 20, olive.color.blue() - 20), 2));
+
+        QRectF oliveRect(bord, bord, size, size * 1.3);
+        painter.drawEllipse(oliveRect);
+
+        painter.setBrush(QBrush(QColor(255, 255, 255, 80)));
+        painter.setPen(Qt::NoPen);
+        painter.drawEllipse(oliveRect.adjusted(size * 0.2, size * 0.2, -size * 0.6, -size * 0.4));
+    }
+
+    QVector<Olive> olives;
+    QPixmap background;
+    QPointer<QWindow> nativeWindow;
+    QMetaObject::Connection frameConnection;
+};
+
+#include "mainwindow.moc"
+
+// =======================
+// Modèles de tables virtuels
+// =======================
+
+PerformanceTableModel::PerformanceTableModel(const QString &titreNom, const PartnerPerformanceIndex &index,
+                                             const LeadTimeIndex &delais, QObject *parent)
+    : QAbstractTableModel(parent), m_titreNom(titreNom), m_index(index), m_delais(delais)
+{
+}
+
+int PerformanceTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_noms.size();
+}
+
+int PerformanceTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 6;
+}
+
+QVariant PerformanceTableModel::data(const QModelIndex &index, int role) const
+{
+    if (role != Qt::DisplayRole || !index.isValid())
+        return QVariant();
+
+    const QString &nom = m_noms[index.row()];
+    const PartnerPerformanceIndex::Stats stats = m_index.stats(nom);
+    switch (index.column()) {
+    case 0: return nom;
+    case 1: return QString::number(stats.total);
+    case 2: return QString::number(stats.livrees);
+    case 3: return QString::number(stats.tauxLivraison(), 'f', 1) + "%";
+    default: break;
+    }
+
+    if (!m_delais.contains(nom))
+        return QString("-");
+    const LeadTimeIndex::Summary delai = m_delais.summary(nom);
+    return QString::number(index.column() == 4 ? delai.p50 : delai.p90);
+}
+
+QVariant PerformanceTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    static const char *const titres[] = {nullptr, "Commandes totales", "Commandes livrées", "Taux (%)",
+                                         "Délai médian (j)", "Délai p90 (j)"};
+    return section == 0 ? m_titreNom : QString(titres[section]);
+}
+
+void PerformanceTableModel::partnerChanged(const QString &nom)
+{
+    // Les partenaires restent triés par nom, comme dans la table d'origine ;
+    // la ligne d'un nom est sa position dans m_noms
+    const auto it = std::lower_bound(m_noms.begin(), m_noms.end(), nom);
+    const int row = int(it - m_noms.begin());
+    const bool present = it != m_noms.end() && *it == nom;
+
+    // Dans un lot, le modèle est en cours de réinitialisation : aucune
+    // notification n'est émise
+    const bool notifier = m_batchDepth == 0;
+
+    if (!m_index.contains(nom)) {
+        if (!present)
+            return;
+        if (notifier)
+            beginRemoveRows(QModelIndex(), row, row);
+        m_noms.remove(row);
+        if (notifier)
+            endRemoveRows();
+        return;
+    }
+
+    if (present) {
+        if (notifier)
+            emit dataChanged(index(row, 1), index(row, 5));
+        return;
+    }
+
+    if (notifier)
+        beginInsertRows(QModelIndex(), row, row);
+    m_noms.insert(row, nom);
+    if (notifier)
+        endInsertRows();
+}
+
+void PerformanceTableModel::beginBatch()
+{
+    if (m_batchDepth++ == 0)
+        beginResetModel();
+}
+
+void PerformanceTableModel::endBatch()
+{
+    if (m_batchDepth > 0 && --m_batchDepth == 0)
+        endResetModel();
+}
+
+FilterProxyModel::FilterProxyModel(QObject *parent)
+    : QAbstractProxyModel(parent)
+{
+}
+
+void FilterProxyModel::setSourceModel(QAbstractItemModel *source)
+{
+    beginResetModel();
+    for (const QMetaObject::Connection &connection : std::as_const(m_connections))
+        disconnect(connection);
+    m_connections.clear();
+
+    QAbstractProxyModel::setSourceModel(source);
+    if (source) {
+        m_connections << connect(source, &QAbstractItemModel::rowsInserted, this, &FilterProxyModel::sourceRowsInserted)
+                      << connect(source, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+                                 &FilterProxyModel::sourceRowsAboutToBeRemoved)
+                      << connect(source, &QAbstractItemModel::rowsRemoved, this, &FilterProxyModel::sourceRowsRemoved)
+                      << connect(source, &QAbstractItemModel::dataChanged, this, &FilterProxyModel::sourceDataChanged)
+                      << connect(source, &QAbstractItemModel::layoutAboutToBeChanged, this,
+                                 &FilterProxyModel::sourceLayoutAboutToBeChanged)
+                      << connect(source, &QAbstractItemModel::layoutChanged, this, &FilterProxyModel::sourceLayoutChanged)
+                      << connect(source, &QAbstractItemModel::modelAboutToBeReset, this,
+                                 &FilterProxyModel::sourceAboutToBeReset)
+                      << connect(source, &QAbstractItemModel::modelReset, this, &FilterProxyModel::sourceReset);
+    }
+    rebuildRows();
+    endResetModel();
+}
+
+void FilterProxyModel::setFilter(Predicate predicate)
+{
+    m_predicate = std::move(predicate);
+    const int count = m_visible.size();
+    if (count == 0)
+        return;
+
+    QBitArray next(count);
+    for (int row = 0; row < count; ++row)
+        next.setBit(row, accepts(row));
+    applyVisibility(0, next);
+}
+
+QModelIndex FilterProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    if (!proxyIndex.isValid() || !sourceModel())
+        return QModelIndex();
+    return sourceModel()->index(sourceRow(proxyIndex.row()), proxyIndex.column());
+}
+
+QModelIndex FilterProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid() || sourceIndex.row() >= m_visible.size() || !m_visible.testBit(sourceIndex.row()))
+        return QModelIndex();
+    return index(proxyRowOf(sourceIndex.row()), sourceIndex.column());
+}
+
+QModelIndex FilterProxyModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || row < 0 || row >= m_rows.size() || column < 0 || column >= columnCount())
+        return QModelIndex();
+    return createIndex(row, column);
+}
+
+QModelIndex FilterProxyModel::parent(const QModelIndex &child) const
+{
+    Q_UNUSED(child);
+    return QModelIndex();
+}
 
-            painter.setBrush(QBrush(olive.color));
-            painter.setPen(QPen(QColor(olive.color.red() - 20, olive.color.green() - 20, olive.color.blue() - 20), 2));
+int FilterProxyModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int FilterProxyModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() || !sourceModel() ? 0 : sourceModel()->columnCount();
+}
+
+QVariant FilterProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    // Les titres de colonnes restent disponibles quand aucune ligne ne passe le filtre
+    if (orientation == Qt::Horizontal && sourceModel())
+        return sourceModel()->headerData(section, orientation, role);
+    return QAbstractItemModel::headerData(section, orientation, role);
+}
 
-            int size = int(olive.size * 15);
-            QRectF oliveRect(olive.pos.x() - size/2, olive.pos.y() - size/2, size, size * 1.3);
-            painter.drawEllipse(oliveRect);
+int FilterProxyModel::proxyRowOf(int sourceRow) const
+{
+    return int(std::lower_bound(m_rows.cbegin(), m_rows.cend(), sourceRow) - m_rows.cbegin());
+}
 
-            painter.setBrush(QBrush(QColor(255, 255, 255, 80)));
-            painter.setPen(Qt::NoPen);
-            painter.drawEllipse(oliveRect.adjusted(size * 0.2, size * 0.2, -size * 0.6, -size * 0.4));
+void FilterProxyModel::rebuildRows()
+{
+    const int count = sourceModel() ? sourceModel()->rowCount() : 0;
+    m_visible = QBitArray(count);
+    m_rows.clear();
+    for (int row = 0; row < count; ++row) {
+        if (accepts(row)) {
+            m_visible.setBit(row);
+            m_rows.append(row);
         }
     }
+}
 
-    void resizeEvent(QResizeEvent *event) override
-    {
-        QWidget::resizeEvent(event);
-        int w = width();
-        int h = height();
-        for (auto &olive : olives) {
-            if (olive.pos.x() > w) olive.pos.setX(w - 50);
-            if (olive.pos.y() > h) olive.pos.setY(h - 50);
-            if (olive.pos.x() < 0) olive.pos.setX(50);
-            if (olive.pos.y() < 0) olive.pos.setY(50);
+// next décrit la visibilité des lignes source [from, from + next.size()[ ;
+// le bit i correspond à la ligne from + i.
+void FilterProxyModel::applyVisibility(int from, const QBitArray &next)
+{
+    const int to = from + next.size() - 1;
+    // Une plage = lignes consécutives qui changent dans le même sens
+    int plages = 0;
+    for (int row = from; row <= to; ++row) {
+        if (next.testBit(row - from) == m_visible.testBit(row))
+            continue;
+        if (row == from || next.testBit(row - 1 - from) == m_visible.testBit(row - 1)
+            || next.testBit(row - 1 - from) != next.testBit(row - from))
+            ++plages;
+    }
+    if (plages == 0)
+        return;
+
+    if (plages > SeuilPlages) {
+        beginResetModel();
+        for (int row = from; row <= to; ++row)
+            m_visible.setBit(row, next.testBit(row - from));
+        m_rows.clear();
+        for (int row = 0; row < m_visible.size(); ++row) {
+            if (m_visible.testBit(row))
+                m_rows.append(row);
+        }
+        endResetModel();
+        return;
+    }
+
+    int proxy = proxyRowOf(from);
+    int row = from;
+    while (row <= to) {
+        const bool visible = next.testBit(row - from);
+        if (visible == m_visible.testBit(row)) {
+            if (visible)
+                ++proxy;
+            ++row;
+            continue;
+        }
+
+        int last = row;
+        while (last < to && next.testBit(last + 1 - from) == visible && m_visible.testBit(last + 1) != visible)
+            ++last;
+        const int count = last - row + 1;
+
+        if (visible) {
+            beginInsertRows(QModelIndex(), proxy, proxy + count - 1);
+            m_rows.insert(proxy, count, 0);
+            for (int i = 0; i < count; ++i) {
+                m_rows[proxy + i] = row + i;
+                m_visible.setBit(row + i);
+            }
+            endInsertRows();
+            proxy += count;
+        } else {
+            beginRemoveRows(QModelIndex(), proxy, proxy + count - 1);
+            m_rows.remove(proxy, count);
+            for (int i = 0; i < count; ++i)
+                m_visible.clearBit(row + i);
+            endRemoveRows();
+        }
+        row = last + 1;
+    }
+}
+
+void FilterProxyModel::sourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+
+    // Seule la fin du bitmap, après le point d'insertion, est décalée
+    const int count = last - first + 1;
+    const int oldSize = m_visible.size();
+    m_visible.resize(oldSize + count);
+    if (first < oldSize) {
+        for (int row = oldSize - 1; row >= first; --row)
+            m_visible.setBit(row + count, m_visible.testBit(row));
+        m_visible.fill(false, first, first + count);
+    }
+
+    // Les lignes visibles situées après le point d'insertion sont décalées
+    const int position = proxyRowOf(first);
+    for (int i = position; i < m_rows.size(); ++i)
+        m_rows[i] += count;
+
+    QVector<int> nouvelles;
+    for (int row = first; row <= last; ++row) {
+        if (accepts(row)) {
+            m_visible.setBit(row);
+            nouvelles.append(row);
         }
     }
+    if (nouvelles.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), position, position + nouvelles.size() - 1);
+    m_rows.insert(position, nouvelles.size(), 0);
+    std::copy(nouvelles.cbegin(), nouvelles.cend(), m_rows.begin() + position);
+    endInsertRows();
+}
+
+void FilterProxyModel::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+
+    const int debut = proxyRowOf(first);
+    const int fin = proxyRowOf(last + 1) - 1;
+    m_removing = debut <= fin;
+    if (m_removing)
+        beginRemoveRows(QModelIndex(), debut, fin);
+}
+
+void FilterProxyModel::sourceRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+
+    const int count = last - first + 1;
+    const int debut = proxyRowOf(first);
+    const int fin = proxyRowOf(last + 1);
+    m_rows.remove(debut, fin - debut);
+    for (int i = debut; i < m_rows.size(); ++i)
+        m_rows[i] -= count;
+
+    // Décalage sur place de la fin du bitmap ; aucune copie du début
+    const int newSize = m_visible.size() - count;
+    for (int row = first; row < newSize; ++row)
+        m_visible.setBit(row, m_visible.testBit(row + count));
+    m_visible.resize(newSize);
+
+    if (m_removing) {
+        m_removing = false;
+        endRemoveRows();
+    }
+}
+
+void FilterProxyModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    if (!topLeft.isValid() || topLeft.parent().isValid())
+        return;
+
+    // Une modification peut faire entrer ou sortir des lignes du filtre
+    const int from = topLeft.row();
+    const int to = bottomRight.row();
+    QBitArray next(to - from + 1);
+    for (int row = from; row <= to; ++row)
+        next.setBit(row - from, accepts(row));
+    applyVisibility(from, next);
+
+    const int debut = proxyRowOf(from);
+    const int fin = proxyRowOf(to + 1) - 1;
+    if (debut <= fin)
+        emit dataChanged(index(debut, topLeft.column()), index(fin, bottomRight.column()));
+}
+
+void FilterProxyModel::sourceLayoutAboutToBeChanged()
+{
+    emit layoutAboutToBeChanged();
+
+    // Chaque index persistant (sélection, index courant) est suivi par sa
+    // ligne source pendant le réordonnancement
+    m_layoutProxies = persistentIndexList();
+    m_layoutSources.clear();
+    for (const QModelIndex &proxyIndex : std::as_const(m_layoutProxies))
+        m_layoutSources.append(QPersistentModelIndex(mapToSource(proxyIndex)));
+}
+
+void FilterProxyModel::sourceLayoutChanged()
+{
+    rebuildRows();
+
+    QModelIndexList apres;
+    apres.reserve(m_layoutSources.size());
+    for (const QPersistentModelIndex &source : std::as_const(m_layoutSources))
+        apres.append(mapFromSource(source));
+    changePersistentIndexList(m_layoutProxies, apres);
+    m_layoutProxies.clear();
+    m_layoutSources.clear();
+
+    emit layoutChanged();
+}
+
+void FilterProxyModel::sourceAboutToBeReset()
+{
+    beginResetModel();
+}
+
+void FilterProxyModel::sourceReset()
+{
+    rebuildRows();
+    endResetModel();
+}
+
+// Hauteur de ligne fixe : la vue calcule la position de chaque ligne sans
+// interroger le modèle, seules les lignes visibles sont formatées
+static void configurerTableVirtuelle(QTableView *table)
+{
+    QHeaderView *lignes = table->verticalHeader();
+    lignes->setSectionResizeMode(QHeaderView::Fixed);
+    lignes->setDefaultSectionSize(table->fontMetrics().height() + 10);
+    table->setWordWrap(false);
+}
 
-    void showEvent(QShowEvent *event) override
-    {
-        QWidget::showEvent(event);
-        if (parentWidget()) {
-            int w = parentWidget()->width();
-            int h = parentWidget()->height();
-            setGeometry(0, 0, w, h);
-            if (olives.isEmpty()) {
-                initializeOlives(w, h);
-            }
-        }
-    }
+// Ligne du modèle source sous l'index courant d'une vue filtrée
+static int ligneCourante(const QTableView *table)
+{
+    const QModelIndex courant = table->currentIndex();
+    if (!courant.isValid())
+        return -1;
+    return static_cast<const FilterProxyModel *>(table->model())->sourceRow(courant.row());
+}
 
-private:
-    struct Olive {
-        QPointF pos;
-        QPointF velocity;
-        double size;
-        QColor color;
-    };
+// Affiche le numéro d'ordre de la ligne : il est calculé au rendu, aucune
+// renumérotation n'est donc nécessaire après un ajout, un tri ou une suppression.
+class OrdinalDelegate : public QStyledItemDelegate
+{
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
 
-    QVector<Olive> olives;
-    QTimer *timer;
+protected:
+    void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override
+    {
+        QStyledItemDelegate::initStyleOption(option, index);
+        option->text = QString::number(index.row() + 1);
+    }
 };
 
-#include "mainwindow.moc"
-
 // =======================
 // Quiz Questions
 // =======================
@@ -322,11 +3330,21 @@ static QVector<QuizQuestion> createOliveraQuiz()
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
-    setupUI();
+    analyticsExecutor = new AnalyticsExecutor(this);
+
     setupStyle();
+    setupModels();
+    setupUI();
+    setupRapports();
 
     resize(1300, 750);
     setMinimumSize(1150, 650);
+
+    // Les transitions de statut échues sont appliquées au démarrage, puis à minuit
+    timerStatuts = new QTimer(this);
+    timerStatuts->setSingleShot(true);
+    connect(timerStatuts, &QTimer::timeout, this, &MainWindow::appliquerTransitionsDatees);
+    appliquerTransitionsDatees();
 }
 
 MainWindow::~MainWindow()
@@ -335,36 +3353,83 @@ MainWindow::~MainWindow()
 
 void MainWindow::setupStyle()
 {
-    QString style = R"(
-        QWidget {
-            background-color: #f4f7f1;
-        }
-        QPushButton {
-            background-color: #7a8f4e;
-            color: white;
-            padding: 8px;
-            border-radius: 6px;
-            font-size: 14px;
-        }
-        QPushButton:hover {
-            background-color: #9bb35d;
-        }
-        QLabel#titleLabel {
-            font-size: 20px;
-            font-weight: bold;
-            color: #5f6f3e;
-        }
-        QFrame#menuFrame {
-            background-color: #5f6f3e;
-        }
-        QLabel#label {
-            font-weight: bold;
-        }
-        QLineEdit[readOnly="true"] {
-            background-color: #f0f0f0;
-        }
-    )";
-    this->setStyleSheet(style);
+    // Le thème est installé pour toute l'application avant la construction
+    // des pages : chaque widget est poli une seule fois, directement avec
+    // son rôle (voir OliveraqTheme)
+    QApplication::setStyle(new OliveraqStyle);
+    QApplication::setPalette(OliveraqTheme::palette());
+}
+
+void MainWindow::setupModels()
+{
+    const auto date = [](const QDate &value) { return value.toString("dd/MM/yyyy"); };
+
+    modeleEmployes = new EmployeeTableModel(employeeStore, {
+        {"ID", [](const EmployeeRecord &r) { return QString::number(r.id); }},
+        {"Nom", [](const EmployeeRecord &r) { return r.nom; }},
+        {"Prénom", [](const EmployeeRecord &r) { return r.prenom; }},
+        {"Poste", [](const EmployeeRecord &r) { return r.poste; }},
+        {"Email", [](const EmployeeRecord &r) { return r.email; }},
+        {"Téléphone", [](const EmployeeRecord &r) { return r.telephone; }},
+        {"Salaire", [](const EmployeeRecord &r) { return QString::number(r.salaire); }},
+        {"Heures", [](const EmployeeRecord &r) { return QString::number(r.heures); }},
+        {"Date embauche", [date](const EmployeeRecord &r) { return date(r.dateEmbauche); }},
+        {"Date naissance", [date](const EmployeeRecord &r) { return date(r.dateNaissance); }},
+    }, this);
+
+    // Commandes fournisseurs et clients : mêmes colonnes, préfixe d'identifiant distinct
+    const auto colonnesCommandes = [date](const QString &prefixe) -> QVector<OrderTableModel::Column> {
+        return {
+            {"ID", [prefixe](const OrderRecord &r) { return prefixe + QString::number(r.id); }},
+            {"Nom", [](const OrderRecord &r) { return r.nom; }},
+            {"Email", [](const OrderRecord &r) { return r.email; }},
+            {"Téléphone", [](const OrderRecord &r) { return r.telephone; }},
+            {"Produit", [](const OrderRecord &r) { return r.produit; }},
+            {"Date commande", [date](const OrderRecord &r) { return date(r.dateCommande); }},
+            {"Date livraison", [date](const OrderRecord &r) { return date(r.dateLivraison); }},
+            {"Prix HT", [](const OrderRecord &r) { return QString::number(r.prixHT); }},
+            {"Mode paiement", [](const OrderRecord &r) { return r.modePaiement; }},
+            {"Statut", [](const OrderRecord &r) { return r.statut; }},
+            {"Quantité", [](const OrderRecord &r) { return QString::number(r.quantite); }},
+            {"Prix TTC", [](const OrderRecord &r) { return QString::number(r.prixTTC, 'f', 2); }},
+        };
+    };
+    modeleFournisseurs = new OrderTableModel(fournisseurStore, colonnesCommandes("CMD-F-"), this);
+    modeleClients = new OrderTableModel(clientStore, colonnesCommandes("CMD-C-"), this);
+
+    // Les colonnes sans objet pour l'olive brute affichent "-"
+    const auto horsOlive = [](const ProductionRecord &r, const QString &texte) {
+        return r.typeProduit == "Olive" ? QString("-") : texte;
+    };
+    modeleProductions = new ProductionTableModel(productionStore, {
+        {"ID", [](const ProductionRecord &r) { return QString::number(r.id); }},
+        {"Identifiant", [](const ProductionRecord &r) { return r.identifiant; }},
+        {"Date production", [date](const ProductionRecord &r) { return date(r.dateProduction); }},
+        {"Type produit", [](const ProductionRecord &r) { return r.typeProduit; }},
+        {"Qte matière (KG)", [](const ProductionRecord &r) { return QString::number(r.quantiteMatiere); }},
+        {"Qte produite (L)", [horsOlive](const ProductionRecord &r) {
+             return horsOlive(r, QString::number(r.quantiteProduite));
+         }},
+        {"Rendement (%)", [horsOlive](const ProductionRecord &r) {
+             return horsOlive(r, QString::number(r.rendement, 'f', 2));
+         }},
+        {"Lot", [](const ProductionRecord &r) { return r.lot; }},
+        {"Qualité", [horsOlive](const ProductionRecord &r) { return horsOlive(r, r.qualite); }},
+    }, this);
+
+    // Chaque table principale est vue à travers son filtre de recherche
+    filtreEmployes = new FilterProxyModel(this);
+    filtreEmployes->setSourceModel(modeleEmployes);
+    filtreFournisseurs = new FilterProxyModel(this);
+    filtreFournisseurs->setSourceModel(modeleFournisseurs);
+    filtreClients = new FilterProxyModel(this);
+    filtreClients->setSourceModel(modeleClients);
+    filtreProductions = new FilterProxyModel(this);
+    filtreProductions->setSourceModel(modeleProductions);
+
+    modelePerformanceFournisseurs = new PerformanceTableModel("Nom fournisseur", fournisseurPerformance,
+                                                              fournisseurDelais, this);
+    modelePerformanceClients = new PerformanceTableModel("Nom client", clientPerformance, clientDelais, this);
 }
 
 void MainWindow::setupUI()
@@ -390,38 +3455,9 @@ void MainWindow::setupUI()
     animatedBg->setAttribute(Qt::WA_TransparentForMouseEvents, true);
     animatedBg->lower();
 
-    QTimer *resizeTimer = new QTimer(pageLogin);
-    QWidget *loginPage = pageLogin;
-    connect(resizeTimer, &QTimer::timeout, [animatedBg, loginPage]() {
-        if (loginPage && animatedBg) {
-            int w = loginPage->width();
-            int h = loginPage->height();
-            if (animatedBg->width() != w || animatedBg->height() != h) {
-                animatedBg->setGeometry(0, 0, w, h);
-                if (animatedBg->width() > 0 && animatedBg->height() > 0) {
-                    animatedBg->initializeOlives(w, h);
-                }
-            }
-        }
-    });
-    resizeTimer->start(100);
-
-    QTimer::singleShot(200, [animatedBg, loginPage]() {
-        if (loginPage && animatedBg) {
-            animatedBg->setGeometry(0, 0, loginPage->width(), loginPage->height());
-            animatedBg->initializeOlives(loginPage->width(), loginPage->height());
-        }
-    });
-
     QWidget *loginContainer = new QWidget(pageLogin);
     loginContainer->setFixedWidth(450);
-    loginContainer->setStyleSheet(
-        "QWidget { "
-        "background-color: #ffffff; "
-        "border: none; "
-        "border-radius: 12px; "
-        "}"
-        );
+    OliveraqTheme::apply(loginContainer, OliveraqTheme::Carte);
 
     QVBoxLayout *containerLayout = new QVBoxLayout(loginContainer);
     containerLayout->setSpacing(0);
@@ -430,119 +3466,36 @@ void MainWindow::setupUI()
     QLabel *loginTitle = new QLabel("Connexion");
     loginTitle->setObjectName("loginTitle");
     loginTitle->setAlignment(Qt::AlignCenter);
-    loginTitle->setStyleSheet(
-        "QLabel { "
-        "font-size: 28px; "
-        "font-weight: 600; "
-        "color: #556b2f; "
-        "margin-bottom: 8px; "
-        "letter-spacing: 0.5px; "
-        "}"
-        );
+    OliveraqTheme::apply(loginTitle, OliveraqTheme::TitreCarte);
+    loginTitle->setContentsMargins(0, 0, 0, 8);
 
     QLabel *loginSubtitle = new QLabel("Accédez à votre espace de gestion");
     loginSubtitle->setAlignment(Qt::AlignCenter);
-    loginSubtitle->setStyleSheet(
-        "QLabel { "
-        "font-size: 13px; "
-        "color: #6b8e23; "
-        "margin-bottom: 35px; "
-        "font-weight: 400; "
-        "}"
-        );
+    OliveraqTheme::apply(loginSubtitle, OliveraqTheme::SousTitreCarte);
+    loginSubtitle->setContentsMargins(0, 0, 0, 35);
 
     QLabel *labelUser = new QLabel("Nom d'utilisateur");
-    labelUser->setStyleSheet(
-        "QLabel { "
-        "font-size: 12px; "
-        "color: #556b2f; "
-        "font-weight: 500; "
-        "margin-bottom: 5px; "
-        "}"
-        );
+    OliveraqTheme::apply(labelUser, OliveraqTheme::LibelleChamp);
+    labelUser->setContentsMargins(0, 0, 0, 5);
 
     editUser = new QLineEdit(loginContainer);
     editUser->setPlaceholderText("Entrez votre nom d'utilisateur");
     editUser->setFixedHeight(42);
-    editUser->setStyleSheet(
-        "QLineEdit { "
-        "font-size: 14px; "
-        "padding: 10px 12px; "
-        "border: 1px solid #c0c0c0; "
-        "border-radius: 6px; "
-        "background-color: #ffffff; "
-        "color: #2c3e50; "
-        "}"
-        "QLineEdit:focus { "
-        "border: 2px solid #6b8e23; "
-        "outline: none; "
-        "background-color: #fafff0; "
-        "}"
-        "QLineEdit:hover { "
-        "border: 1px solid #9aab6b; "
-        "}"
-        );
+    OliveraqTheme::apply(editUser, OliveraqTheme::Champ);
 
     QLabel *labelPass = new QLabel("Mot de passe");
-    labelPass->setStyleSheet(
-        "QLabel { "
-        "font-size: 12px; "
-        "color: #556b2f; "
-        "font-weight: 500; "
-        "margin-top: 15px; "
-        "margin-bottom: 5px; "
-        "}"
-        );
+    OliveraqTheme::apply(labelPass, OliveraqTheme::LibelleChamp);
+    labelPass->setContentsMargins(0, 15, 0, 5);
 
     editPass = new QLineEdit(loginContainer);
     editPass->setPlaceholderText("Entrez votre mot de passe");
     editPass->setEchoMode(QLineEdit::Password);
     editPass->setFixedHeight(42);
-    editPass->setStyleSheet(
-        "QLineEdit { "
-        "font-size: 14px; "
-        "padding: 10px 12px; "
-        "border: 1px solid #c0c0c0; "
-        "border-radius: 6px; "
-        "background-color: #ffffff; "
-        "color: #2c3e50; "
-        "}"
-        "QLineEdit:focus { "
-        "border: 2px solid #6b8e23; "
-        "outline: none; "
-        "background-color: #fafff0; "
-        "}"
-        "QLineEdit:hover { "
-        "border: 1px solid #9aab6b; "
-        "}"
-        );
+    OliveraqTheme::apply(editPass, OliveraqTheme::Champ);
 
     btnLogin = new QPushButton("Se connecter", loginContainer);
     btnLogin->setFixedHeight(44);
-    btnLogin->setStyleSheet(
-        "QPushButton { "
-        "font-size: 14px; "
-        "font-weight: 600; "
-        "color: #ffffff; "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #6b8e23, "
-        "stop:1 #556b2f); "
-        "border: none; "
-        "border-radius: 6px; "
-        "padding: 11px; "
-        "letter-spacing: 0.3px; "
-        "}"
-        "QPushButton:hover { "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #7a9e2d, "
-        "stop:1 #6b8e23); "
-        "}"
-        "QPushButton:pressed { "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #556b2f, "
-        "stop:1 #4a5a26); "
-        "}"
-        );
+    OliveraqTheme::apply(btnLogin, OliveraqTheme::BoutonPrincipal);
 
     containerLayout->addWidget(loginTitle);
     containerLayout->addWidget(loginSubtitle);
@@ -559,22 +3512,16 @@ void MainWindow::setupUI()
 
     connect(btnLogin, &QPushButton::clicked, this, [=]() {
         mainStack->setCurrentWidget(pageMenu);
+        // Les pages de gestion sont construites pendant que l'utilisateur
+        // parcourt le menu
+        QTimer::singleShot(0, this, &MainWindow::prewarmNextPage);
     });
 
     // ======================================
     // PAGE MENU
     // ======================================
     pageMenu = new QWidget(this);
-    pageMenu->setStyleSheet(
-        "QWidget { "
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "stop:0 #556b2f, "
-        "stop:0.25 #6b8e23, "
-        "stop:0.5 #808000, "
-        "stop:0.75 #6b8e23, "
-        "stop:1 #556b2f); "
-        "}"
-        );
+    OliveraqTheme::apply(pageMenu, OliveraqTheme::PageDegradee);
 
     QVBoxLayout *menuLayout = new QVBoxLayout(pageMenu);
     menuLayout->setContentsMargins(0, 0, 0, 0);
@@ -583,14 +3530,7 @@ void MainWindow::setupUI()
 
     QWidget *headerWidget = new QWidget(pageMenu);
     headerWidget->setFixedHeight(80);
-    headerWidget->setStyleSheet(
-        "QWidget { "
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:0, "
-        "stop:0 #556b2f, "
-        "stop:1 #6b8e23); "
-        "border-bottom: 3px solid #4a5a26; "
-        "}"
-        );
+    OliveraqTheme::apply(headerWidget, OliveraqTheme::Bandeau);
 
     QVBoxLayout *menuHeaderLayout = new QVBoxLayout(headerWidget);
     menuHeaderLayout->setContentsMargins(40, 0, 40, 0);
@@ -598,24 +3538,12 @@ void MainWindow::setupUI()
 
     QLabel *menuTitle = new QLabel("Menu Principal");
     menuTitle->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    menuTitle->setStyleSheet(
-        "QLabel { "
-        "font-size: 24px; "
-        "font-weight: 600; "
-        "color: #ffffff; "
-        "letter-spacing: 0.5px; "
-        "text-shadow: 1px 1px 2px rgba(0,0,0,0.3); "
-        "}"
-        );
+    OliveraqTheme::apply(menuTitle, OliveraqTheme::TitreBandeau);
 
     menuHeaderLayout->addWidget(menuTitle);
 
     QWidget *buttonsContainer = new QWidget(pageMenu);
-    buttonsContainer->setStyleSheet(
-        "QWidget { "
-        "background-color: #ffffff; "
-        "}"
-        );
+    OliveraqTheme::apply(buttonsContainer, OliveraqTheme::PanneauBlanc);
 
     QVBoxLayout *buttonsLayout = new QVBoxLayout(buttonsContainer);
     buttonsLayout->setSpacing(0);
@@ -629,37 +3557,9 @@ void MainWindow::setupUI()
     btnModifMotDePasse   = new QPushButton("Modifier mot de passe", buttonsContainer);
     btnQuiz              = new QPushButton("🎓 Quiz pédagogique OLIVERAQ", buttonsContainer);
 
-    QString buttonStyle =
-        "QPushButton { "
-        "font-size: 14px; "
-        "font-weight: 500; "
-        "color: #2c3e50; "
-        "background-color: #ffffff; "
-        "border: 1px solid #e0e0e0; "
-        "border-left: 4px solid #ecf0f1; "
-        "border-radius: 0px; "
-        "padding: 16px 20px; "
-        "text-align: left; "
-        "min-height: 50px; "
-        "}"
-        "QPushButton:hover { "
-        "background-color: #fafff0; "
-        "border-left: 4px solid #6b8e23; "
-        "color: #556b2f; "
-        "}"
-        "QPushButton:pressed { "
-        "background-color: #f0f5e0; "
-        "border-left: 4px solid #556b2f; "
-        "color: #4a5a26; "
-        "}";
-
-    btnGestionEmployes->setStyleSheet(buttonStyle);
-    btnGestionClients->setStyleSheet(buttonStyle);
-    btnGestionStocks->setStyleSheet(buttonStyle);
-    btnGestionVentes->setStyleSheet(buttonStyle);
-    btnFournisseur->setStyleSheet(buttonStyle);
-    btnModifMotDePasse->setStyleSheet(buttonStyle);
-    btnQuiz->setStyleSheet(buttonStyle);
+    for (QPushButton *button : {btnGestionEmployes, btnGestionClients, btnGestionStocks, btnGestionVentes,
+                                btnFournisseur, btnModifMotDePasse, btnQuiz})
+        OliveraqTheme::apply(button, OliveraqTheme::BoutonMenu);
 
     buttonsLayout->addWidget(btnGestionEmployes);
     buttonsLayout->addWidget(btnGestionClients);
@@ -678,24 +3578,19 @@ void MainWindow::setupUI()
     connect(btnGestionEmployes, &QPushButton::clicked, this, &MainWindow::openGestionEmployes);
     connect(btnGestionClients, &QPushButton::clicked, this, &MainWindow::openGestionClients);
     connect(btnGestionStocks, &QPushButton::clicked, this, &MainWindow::openGestionStocks);
+    connect(btnGestionVentes, &QPushButton::clicked, this, &MainWindow::openGestionVentes);
     connect(btnModifMotDePasse, &QPushButton::clicked, this, &MainWindow::openChangePassword);
     connect(btnFournisseur, &QPushButton::clicked, this, &MainWindow::openGestionFournisseurs);
     connect(btnQuiz, &QPushButton::clicked, this, &MainWindow::openQuiz);
+}
 
+void MainWindow::buildPageChangePassword()
+{
     // ======================================
     // PAGE CHANGEMENT MOT DE PASSE
     // ======================================
     pageChangePassword = new QWidget(this);
-    pageChangePassword->setStyleSheet(
-        "QWidget { "
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "stop:0 #556b2f, "
-        "stop:0.25 #6b8e23, "
-        "stop:0.5 #808000, "
-        "stop:0.75 #6b8e23, "
-        "stop:1 #556b2f); "
-        "}"
-        );
+    OliveraqTheme::apply(pageChangePassword, OliveraqTheme::PageDegradee);
 
     QVBoxLayout *passLayout = new QVBoxLayout(pageChangePassword);
     passLayout->setContentsMargins(0, 0, 0, 0);
@@ -704,14 +3599,7 @@ void MainWindow::setupUI()
 
     QWidget *passHeaderWidget = new QWidget(pageChangePassword);
     passHeaderWidget->setFixedHeight(80);
-    passHeaderWidget->setStyleSheet(
-        "QWidget { "
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:0, "
-        "stop:0 #556b2f, "
-        "stop:1 #6b8e23); "
-        "border-bottom: 3px solid #4a5a26; "
-        "}"
-        );
+    OliveraqTheme::apply(passHeaderWidget, OliveraqTheme::Bandeau);
 
     QVBoxLayout *passHeaderLayout = new QVBoxLayout(passHeaderWidget);
     passHeaderLayout->setContentsMargins(40, 0, 40, 0);
@@ -719,24 +3607,12 @@ void MainWindow::setupUI()
 
     QLabel *passTitle = new QLabel("Modifier mot de passe");
     passTitle->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    passTitle->setStyleSheet(
-        "QLabel { "
-        "font-size: 24px; "
-        "font-weight: 600; "
-        "color: #ffffff; "
-        "letter-spacing: 0.5px; "
-        "text-shadow: 1px 1px 2px rgba(0,0,0,0.3); "
-        "}"
-        );
+    OliveraqTheme::apply(passTitle, OliveraqTheme::TitreBandeau);
 
     passHeaderLayout->addWidget(passTitle);
 
     QWidget *passContainer = new QWidget(pageChangePassword);
-    passContainer->setStyleSheet(
-        "QWidget { "
-        "background-color: #ffffff; "
-        "}"
-        );
+    OliveraqTheme::apply(passContainer, OliveraqTheme::PanneauBlanc);
 
     QVBoxLayout *passContainerLayout = new QVBoxLayout(passContainer);
     passContainerLayout->setContentsMargins(60, 50, 60, 50);
@@ -744,160 +3620,47 @@ void MainWindow::setupUI()
     passContainerLayout->setAlignment(Qt::AlignCenter);
 
     QLabel *labelOldPass = new QLabel("Ancien mot de passe");
-    labelOldPass->setStyleSheet(
-        "QLabel { "
-        "font-size: 13px; "
-        "color: #556b2f; "
-        "font-weight: 500; "
-        "margin-bottom: 5px; "
-        "}"
-        );
+    OliveraqTheme::apply(labelOldPass, OliveraqTheme::LibelleChamp);
+    labelOldPass->setContentsMargins(0, 0, 0, 5);
 
     editOldPass = new QLineEdit(passContainer);
     editOldPass->setPlaceholderText("Entrez votre ancien mot de passe");
     editOldPass->setEchoMode(QLineEdit::Password);
     editOldPass->setFixedHeight(42);
-    editOldPass->setStyleSheet(
-        "QLineEdit { "
-        "font-size: 14px; "
-        "padding: 10px 12px; "
-        "border: 1px solid #d5d5d5; "
-        "border-radius: 6px; "
-        "background-color: #ffffff; "
-        "color: #2c3e50; "
-        "}"
-        "QLineEdit:focus { "
-        "border: 2px solid #6b8e23; "
-        "outline: none; "
-        "background-color: #fafff0; "
-        "}"
-        "QLineEdit:hover { "
-        "border: 1px solid #9aab6b; "
-        "}"
-        );
+    OliveraqTheme::apply(editOldPass, OliveraqTheme::Champ);
 
     QLabel *labelNewPass = new QLabel("Nouveau mot de passe");
-    labelNewPass->setStyleSheet(
-        "QLabel { "
-        "font-size: 13px; "
-        "color: #556b2f; "
-        "font-weight: 500; "
-        "margin-top: 10px; "
-        "margin-bottom: 5px; "
-        "}"
-        );
+    OliveraqTheme::apply(labelNewPass, OliveraqTheme::LibelleChamp);
+    labelNewPass->setContentsMargins(0, 10, 0, 5);
 
     editNewPass = new QLineEdit(passContainer);
     editNewPass->setPlaceholderText("Entrez votre nouveau mot de passe");
     editNewPass->setEchoMode(QLineEdit::Password);
     editNewPass->setFixedHeight(42);
-    editNewPass->setStyleSheet(
-        "QLineEdit { "
-        "font-size: 14px; "
-        "padding: 10px 12px; "
-        "border: 1px solid #d5d5d5; "
-        "border-radius: 6px; "
-        "background-color: #ffffff; "
-        "color: #2c3e50; "
-        "}"
-        "QLineEdit:focus { "
-        "border: 2px solid #6b8e23; "
-        "outline: none; "
-        "background-color: #fafff0; "
-        "}"
-        "QLineEdit:hover { "
-        "border: 1px solid #9aab6b; "
-        "}"
-        );
+    OliveraqTheme::apply(editNewPass, OliveraqTheme::Champ);
 
     QLabel *labelConfirmPass = new QLabel("Confirmer le mot de passe");
-    labelConfirmPass->setStyleSheet(
-        "QLabel { "
-        "font-size: 13px; "
-        "color: #556b2f; "
-        "font-weight: 500; "
-        "margin-top: 10px; "
-        "margin-bottom: 5px; "
-        "}"
-        );
+    OliveraqTheme::apply(labelConfirmPass, OliveraqTheme::LibelleChamp);
+    labelConfirmPass->setContentsMargins(0, 10, 0, 5);
 
     editConfirmPass = new QLineEdit(passContainer);
     editConfirmPass->setPlaceholderText("Confirmez votre nouveau mot de passe");
     editConfirmPass->setEchoMode(QLineEdit::Password);
     editConfirmPass->setFixedHeight(42);
-    editConfirmPass->setStyleSheet(
-        "QLineEdit { "
-        "font-size: 14px; "
-        "padding: 10px 12px; "
-        "border: 1px solid #d5d5d5; "
-        "border-radius: 6px; "
-        "background-color: #ffffff; "
-        "color: #2c3e50; "
-        "}"
-        "QLineEdit:focus { "
-        "border: 2px solid #6b8e23; "
-        "outline: none; "
-        "background-color: #fafff0; "
-        "}"
-        "QLineEdit:hover { "
-        "border: 1px solid #9aab6b; "
-        "}"
-        );
+    OliveraqTheme::apply(editConfirmPass, OliveraqTheme::Champ);
 
     QHBoxLayout *btnPassLayout = new QHBoxLayout();
     btnPassLayout->setSpacing(15);
 
     btnSavePass = new QPushButton("Sauvegarder", passContainer);
     btnSavePass->setFixedHeight(44);
-    btnSavePass->setStyleSheet(
-        "QPushButton { "
-        "font-size: 14px; "
-        "font-weight: 600; "
-        "color: #ffffff; "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #6b8e23, "
-        "stop:1 #556b2f); "
-        "border: none; "
-        "border-radius: 6px; "
-        "padding: 11px 30px; "
-        "letter-spacing: 0.3px; "
-        "min-width: 150px; "
-        "}"
-        "QPushButton:hover { "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #7a9e2d, "
-        "stop:1 #6b8e23); "
-        "}"
-        "QPushButton:pressed { "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #556b2f, "
-        "stop:1 #4a5a26); "
-        "}"
-        );
+    OliveraqTheme::apply(btnSavePass, OliveraqTheme::BoutonPrincipal);
+    btnSavePass->setMinimumWidth(150);
 
     btnBackPass = new QPushButton("Retour", passContainer);
     btnBackPass->setFixedHeight(44);
-    btnBackPass->setStyleSheet(
-        "QPushButton { "
-        "font-size: 14px; "
-        "font-weight: 600; "
-        "color: #556b2f; "
-        "background-color: #ffffff; "
-        "border: 2px solid #6b8e23; "
-        "border-radius: 6px; "
-        "padding: 11px 30px; "
-        "letter-spacing: 0.3px; "
-        "min-width: 150px; "
-        "}"
-        "QPushButton:hover { "
-        "background-color: #fafff0; "
-        "border: 2px solid #556b2f; "
-        "color: #4a5a26; "
-        "}"
-        "QPushButton:pressed { "
-        "background-color: #f0f5e0; "
-        "}"
-        );
+    OliveraqTheme::apply(btnBackPass, OliveraqTheme::BoutonSecondaire);
+    btnBackPass->setMinimumWidth(150);
 
     btnPassLayout->addStretch();
     btnPassLayout->addWidget(btnBackPass);
@@ -923,7 +3686,10 @@ void MainWindow::setupUI()
 
     connect(btnSavePass, &QPushButton::clicked, this, &MainWindow::changePassword);
     connect(btnBackPass, &QPushButton::clicked, this, &MainWindow::backToMenu);
+}
 
+void MainWindow::buildPageEmployes()
+{
     // ======================================
     // PAGE EMPLOYES
     // ======================================
@@ -938,80 +3704,32 @@ void MainWindow::setupUI()
 
     QWidget *headerEmp = new QWidget(left);
     headerEmp->setFixedHeight(80);
-    headerEmp->setStyleSheet(
-        "QWidget { "
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:0, "
-        "stop:0 #556b2f, stop:1 #6b8e23); "
-        "border-bottom: 3px solid #4a5a26; "
-        "}"
-        );
+    OliveraqTheme::apply(headerEmp, OliveraqTheme::Bandeau);
 
     QHBoxLayout *headerLayout = new QHBoxLayout(headerEmp);
     headerLayout->setContentsMargins(20, 0, 20, 0);
     headerLayout->setSpacing(10);
 
     QLabel *titleEmp = new QLabel("📋 EMPLOYÉS", headerEmp);
-    titleEmp->setStyleSheet("color:white; font-size:18px; font-weight:bold;");
+    OliveraqTheme::apply(titleEmp, OliveraqTheme::TitreMenu);
     titleEmp->setAlignment(Qt::AlignCenter);
 
     editSearch = new QLineEdit(headerEmp);
     editSearch->setPlaceholderText("Rechercher par nom...");
     editSearch->setFixedHeight(40);
     editSearch->setFixedWidth(250);
-    editSearch->setStyleSheet(
-        "QLineEdit { "
-        "font-size: 13px; "
-        "padding: 8px 12px; "
-        "border: 1px solid #d5d5d5; "
-        "border-radius: 6px; "
-        "background-color: #ffffff; "
-        "color: #2c3e50; "
-        "margin-right: 10px; "
-        "}"
-        "QLineEdit:focus { "
-        "border: 2px solid #6b8e23; "
-        "outline: none; "
-        "}"
-        );
+    OliveraqTheme::apply(editSearch, OliveraqTheme::Champ);
 
     QPushButton *btnSearchEmp = new QPushButton("🔍", headerEmp);
     btnSearchEmp->setFixedSize(40, 40);
-    btnSearchEmp->setStyleSheet(
-        "QPushButton { "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #6b8e23, stop:1 #556b2f); "
-        "color: white; "
-        "font-size: 16px; "
-        "border: none; "
-        "border-radius: 6px; "
-        "font-weight: bold; "
-        "}"
-        "QPushButton:hover { "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #7a9e2d, stop:1 #6b8e23); "
-        "}"
-        );
+    OliveraqTheme::apply(btnSearchEmp, OliveraqTheme::BoutonPrincipal);
 
     comboSort = new QComboBox(headerEmp);
     comboSort->addItem("Trier par salaire (croissant)");
     comboSort->addItem("Trier par salaire (décroissant)");
     comboSort->setFixedHeight(40);
     comboSort->setFixedWidth(280);
-    comboSort->setStyleSheet(
-        "QComboBox { "
-        "font-size: 13px; "
-        "padding: 8px 12px; "
-        "border: 1px solid #d5d5d5; "
-        "border-radius: 6px; "
-        "background-color: #ffffff; "
-        "color: #2c3e50; "
-        "margin-right: 10px; "
-        "}"
-        "QComboBox:hover { "
-        "border: 2px solid #6b8e23; "
-        "}"
-        "QComboBox::drop-down { border: none; }"
-        );
+    OliveraqTheme::apply(comboSort, OliveraqTheme::Champ);
 
     headerLayout->addWidget(titleEmp);
     headerLayout->addStretch();
@@ -1021,30 +3739,15 @@ void MainWindow::setupUI()
 
     leftLayout->addWidget(headerEmp);
 
-    tableEmployes = new QTableWidget(left);
-    tableEmployes->setColumnCount(10);
-    tableEmployes->setHorizontalHeaderLabels(
-        {"ID","Nom","Prénom","Poste","Email","Téléphone","Salaire","Heures","Date embauche","Date naissance"});
+    tableEmployes = new QTableView(left);
+    tableEmployes->setModel(filtreEmployes);
+    configurerTableVirtuelle(tableEmployes);
     tableEmployes->setEditTriggers(QAbstractItemView::NoEditTriggers);
     tableEmployes->setSelectionBehavior(QAbstractItemView::SelectRows);
     tableEmployes->setAlternatingRowColors(true);
     tableEmployes->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    tableEmployes->setStyleSheet(
-        "QTableWidget { "
-        "gridline-color: #e0e0e0; "
-        "background-color: #ffffff; "
-        "border: 1px solid #e0e0e0; "
-        "border-radius: 6px; "
-        "}"
-        "QTableWidget::item { padding: 8px; } "
-        "QHeaderView::section { "
-        "background-color: #f5f7fa; "
-        "color: #556b2f; "
-        "font-weight: 600; "
-        "padding: 10px; "
-        "border: 1px solid #e0e0e0; "
-        "}"
-        );
+    tableEmployes->setItemDelegateForColumn(0, new OrdinalDelegate(tableEmployes));
+    OliveraqTheme::apply(tableEmployes, OliveraqTheme::Tableau);
 
     leftLayout->addWidget(tableEmployes);
 
@@ -1063,13 +3766,13 @@ void MainWindow::setupUI()
     QFormLayout *rightEmpLayout = new QFormLayout(right);
 
     chartTitle = new QLabel("Pourcentage d'employés selon l'âge", right);
-    chartTitle->setObjectName("titleLabel");
+    OliveraqTheme::apply(chartTitle, OliveraqTheme::Titre);
     chartTitle->setAlignment(Qt::AlignCenter);
 
     chartWidget = new PieChartWidget(right);
 
     formTitle = new QLabel("Ajouter un employé", right);
-    formTitle->setObjectName("titleLabel");
+    OliveraqTheme::apply(formTitle, OliveraqTheme::Titre);
     formTitle->setAlignment(Qt::AlignCenter);
 
     editNom = new QLineEdit(right);
@@ -1116,11 +3819,14 @@ void MainWindow::setupUI()
     connect(btnSupprimer, &QPushButton::clicked, this, &MainWindow::supprimer);
     connect(btnEnregistrer, &QPushButton::clicked, this, &MainWindow::enregistrer);
     connect(btnExtractionAttestation, &QPushButton::clicked, this, &MainWindow::extractAttestation);
-    connect(tableEmployes, &QTableWidget::itemSelectionChanged, this, &MainWindow::tableSelectionChanged);
+    connect(tableEmployes->selectionModel(), &QItemSelectionModel::selectionChanged, this, &MainWindow::tableSelectionChanged);
     connect(editSearch, &QLineEdit::textChanged, this, &MainWindow::searchByName);
     connect(btnSearchEmp, &QPushButton::clicked, this, &MainWindow::searchByName);
     connect(comboSort, &QComboBox::currentIndexChanged, this, &MainWindow::sortBySalary);
+}
 
+void MainWindow::buildPageFournisseurs()
+{
     // ======================================
     // PAGE GESTION FOURNISSEURS
     // ======================================
@@ -1131,31 +3837,23 @@ void MainWindow::setupUI()
 
     // Menu latéral gauche
     QFrame *menuFrameFournisseurs = new QFrame(pageFournisseurs);
-    menuFrameFournisseurs->setObjectName("menuFrame");
+    OliveraqTheme::apply(menuFrameFournisseurs, OliveraqTheme::PanneauLateral);
     menuFrameFournisseurs->setFixedWidth(250);
     QVBoxLayout *menuLayoutFournisseurs = new QVBoxLayout(menuFrameFournisseurs);
     menuLayoutFournisseurs->setContentsMargins(15, 30, 15, 20);
     menuLayoutFournisseurs->setSpacing(15);
 
     QLabel *titleMenuFournisseurs = new QLabel("GESTION FOURNISSEURS", menuFrameFournisseurs);
-    titleMenuFournisseurs->setStyleSheet("color:white; font-size:18px; font-weight:bold;");
+    OliveraqTheme::apply(titleMenuFournisseurs, OliveraqTheme::TitreMenu);
     titleMenuFournisseurs->setAlignment(Qt::AlignCenter);
 
     btnListeFournisseurs = new QPushButton("📋 Liste des fournisseurs", menuFrameFournisseurs);
     btnAjouterFournisseur = new QPushButton("➕ Ajouter fournisseur", menuFrameFournisseurs);
     btnRetourMenuFournisseurs = new QPushButton("🔙 Retour au menu", menuFrameFournisseurs);
 
-    QString menuBtnStyle =
-        "QPushButton { "
-        "background-color: #7a8f4e; color: white; "
-        "padding: 12px; border-radius: 6px; "
-        "font-size: 13px; text-align: left; "
-        "}"
-        "QPushButton:hover { background-color: #9bb35d; }";
-
-    btnListeFournisseurs->setStyleSheet(menuBtnStyle);
-    btnAjouterFournisseur->setStyleSheet(menuBtnStyle);
-    btnRetourMenuFournisseurs->setStyleSheet(menuBtnStyle);
+    OliveraqTheme::apply(btnListeFournisseurs, OliveraqTheme::BoutonLateral);
+    OliveraqTheme::apply(btnAjouterFournisseur, OliveraqTheme::BoutonLateral);
+    OliveraqTheme::apply(btnRetourMenuFournisseurs, OliveraqTheme::BoutonLateral);
 
     menuLayoutFournisseurs->addWidget(titleMenuFournisseurs);
     menuLayoutFournisseurs->addSpacing(20);
@@ -1178,7 +3876,7 @@ void MainWindow::setupUI()
     // Header avec recherche et tri
     QHBoxLayout *headerFournisseursLayout = new QHBoxLayout();
     QLabel *titleListeFournisseurs = new QLabel("📋 LISTE DES FOURNISSEURS");
-    titleListeFournisseurs->setObjectName("titleLabel");
+    OliveraqTheme::apply(titleListeFournisseurs, OliveraqTheme::Titre);
 
     searchFournisseurEdit = new QLineEdit(pageListeFournisseurs);
     searchFournisseurEdit->setPlaceholderText("🔍 Rechercher par nom...");
@@ -1191,12 +3889,14 @@ void MainWindow::setupUI()
     comboSortFournisseurs->setFixedWidth(200);
 
     btnExportPDF = new QPushButton("📄 Exporter facture", pageListeFournisseurs);
+    btnExportLot = new QPushButton("🗂 Export groupé", pageListeFournisseurs);
 
     headerFournisseursLayout->addWidget(titleListeFournisseurs);
     headerFournisseursLayout->addStretch();
     headerFournisseursLayout->addWidget(searchFournisseurEdit);
     headerFournisseursLayout->addWidget(comboSortFournisseurs);
     headerFournisseursLayout->addWidget(btnExportPDF);
+    headerFournisseursLayout->addWidget(btnExportLot);
 
     // Statistiques fournisseurs
     QHBoxLayout *statsFournisseursLayout = new QHBoxLayout();
@@ -1207,12 +3907,11 @@ void MainWindow::setupUI()
     labelCommandesLivrees = new QLabel("Livrées: 0");
     labelTauxLivraison = new QLabel("Taux livraison: 0%");
 
-    QString statStyle = "QLabel { padding: 10px; background-color: #e8f5e9; border-radius: 6px; font-weight: bold; }";
-    labelTotalFournisseurs->setStyleSheet(statStyle);
-    labelTotalCommandes->setStyleSheet(statStyle);
-    labelCommandesEnCours->setStyleSheet(statStyle);
-    labelCommandesLivrees->setStyleSheet(statStyle);
-    labelTauxLivraison->setStyleSheet(statStyle);
+    OliveraqTheme::apply(labelTotalFournisseurs, OliveraqTheme::Indicateur);
+    OliveraqTheme::apply(labelTotalCommandes, OliveraqTheme::Indicateur);
+    OliveraqTheme::apply(labelCommandesEnCours, OliveraqTheme::Indicateur);
+    OliveraqTheme::apply(labelCommandesLivrees, OliveraqTheme::Indicateur);
+    OliveraqTheme::apply(labelTauxLivraison, OliveraqTheme::Indicateur);
 
     statsFournisseursLayout->addWidget(labelTotalFournisseurs);
     statsFournisseursLayout->addWidget(labelTotalCommandes);
@@ -1224,13 +3923,9 @@ void MainWindow::setupUI()
     chartFournisseurs = new PieChartWidget(pageListeFournisseurs);
 
     // Table fournisseurs
-    tableFournisseurs = new QTableWidget(pageListeFournisseurs);
-    tableFournisseurs->setColumnCount(12);
-    tableFournisseurs->setHorizontalHeaderLabels({
-        "ID", "Nom", "Email", "Téléphone", "Produit",
-        "Date commande", "Date livraison", "Prix HT",
-        "Mode paiement", "Statut", "Quantité", "Prix TTC"
-    });
+    tableFournisseurs = new QTableView(pageListeFournisseurs);
+    tableFournisseurs->setModel(filtreFournisseurs);
+    configurerTableVirtuelle(tableFournisseurs);
     tableFournisseurs->setEditTriggers(QAbstractItemView::NoEditTriggers);
     tableFournisseurs->setSelectionBehavior(QAbstractItemView::SelectRows);
     tableFournisseurs->setAlternatingRowColors(true);
@@ -1249,14 +3944,38 @@ void MainWindow::setupUI()
 
     // Performance fournisseurs
     QLabel *perfTitle = new QLabel("📊 Performance des fournisseurs");
-    perfTitle->setObjectName("titleLabel");
+    OliveraqTheme::apply(perfTitle, OliveraqTheme::Titre);
 
-    tablePerformance = new QTableWidget(pageListeFournisseurs);
-    tablePerformance->setColumnCount(4);
-    tablePerformance->setHorizontalHeaderLabels({"Nom fournisseur", "Commandes totales", "Commandes livrées", "Taux (%)"});
+    tablePerformance = new QTableView(pageListeFournisseurs);
+    tablePerformance->setModel(modelePerformanceFournisseurs);
+    configurerTableVirtuelle(tablePerformance);
     tablePerformance->setMaximumHeight(150);
     tablePerformance->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
 
+    // Classement des fournisseurs par délai de livraison (du plus rapide au plus lent)
+    tableClassementDelais = new QTableWidget(pageListeFournisseurs);
+    tableClassementDelais->setColumnCount(4);
+    tableClassementDelais->setHorizontalHeaderLabels({"Fournisseur", "Livrées", "Délai médian (j)", "Délai p90 (j)"});
+    tableClassementDelais->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableClassementDelais->setMaximumHeight(150);
+    tableClassementDelais->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    QHBoxLayout *perfFournisseursLayout = new QHBoxLayout();
+    perfFournisseursLayout->addWidget(tablePerformance, 3);
+    perfFournisseursLayout->addWidget(tableClassementDelais, 2);
+
+    // Dettes fournisseurs (reste à payer) par ancienneté
+    QLabel *encoursTitleFournisseurs = new QLabel("💰 Reste à payer aux fournisseurs par ancienneté");
+    OliveraqTheme::apply(encoursTitleFournisseurs, OliveraqTheme::Titre);
+
+    tableEncoursFournisseurs = new QTableWidget(pageListeFournisseurs);
+    tableEncoursFournisseurs->setColumnCount(6);
+    tableEncoursFournisseurs->setHorizontalHeaderLabels({"Fournisseur", "0-30 j", "31-60 j", "61-90 j", "+90 j", "Total (DT)"});
+    tableEncoursFournisseurs->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableEncoursFournisseurs->verticalHeader()->setVisible(false);
+    tableEncoursFournisseurs->setMaximumHeight(150);
+    tableEncoursFournisseurs->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
     labelMeilleurFournisseur = new QLabel("🏆 Meilleur fournisseur: -");
     labelFournisseurRapide = new QLabel("⚡ Fournisseur le plus rapide: -");
 
@@ -1266,7 +3985,9 @@ void MainWindow::setupUI()
     listeFournisseursLayout->addWidget(tableFournisseurs);
     listeFournisseursLayout->addLayout(btnFournisseursLayout);
     listeFournisseursLayout->addWidget(perfTitle);
-    listeFournisseursLayout->addWidget(tablePerformance);
+    listeFournisseursLayout->addLayout(perfFournisseursLayout);
+    listeFournisseursLayout->addWidget(encoursTitleFournisseurs);
+    listeFournisseursLayout->addWidget(tableEncoursFournisseurs);
     listeFournisseursLayout->addWidget(labelMeilleurFournisseur);
     listeFournisseursLayout->addWidget(labelFournisseurRapide);
 
@@ -1281,7 +4002,7 @@ void MainWindow::setupUI()
     formFournisseursLayout->setSpacing(15);
 
     QLabel *titleFormFournisseur = new QLabel("➕ AJOUTER/MODIFIER FOURNISSEUR");
-    titleFormFournisseur->setObjectName("titleLabel");
+    OliveraqTheme::apply(titleFormFournisseur, OliveraqTheme::Titre);
     titleFormFournisseur->setAlignment(Qt::AlignCenter);
 
     QScrollArea *scrollFournisseur = new QScrollArea(pageFormulaireFournisseurs);
@@ -1295,7 +4016,8 @@ void MainWindow::setupUI()
 
     // Informations fournisseur
     QLabel *infoFournisseurLabel = new QLabel("Informations du fournisseur");
-    infoFournisseurLabel->setStyleSheet("font-size: 16px; font-weight: bold; color: #556b2f; margin-top: 10px;");
+    OliveraqTheme::apply(infoFournisseurLabel, OliveraqTheme::SousSection);
+    infoFournisseurLabel->setContentsMargins(0, 10, 0, 0);
 
     editNomFournisseur = new QLineEdit();
     editEmailFournisseur = new QLineEdit();
@@ -1304,7 +4026,8 @@ void MainWindow::setupUI()
 
     // Informations commande
     QLabel *infoCommandeLabel = new QLabel("Informations de la commande");
-    infoCommandeLabel->setStyleSheet("font-size: 16px; font-weight: bold; color: #556b2f; margin-top: 10px;");
+    OliveraqTheme::apply(infoCommandeLabel, OliveraqTheme::SousSection);
+    infoCommandeLabel->setContentsMargins(0, 10, 0, 0);
 
     editIDCommande = new QLineEdit();
     editIDCommande->setReadOnly(true);
@@ -1384,7 +4107,7 @@ void MainWindow::setupUI()
     detailsFournisseursLayout->setSpacing(15);
 
     detailsTitle = new QLabel("📄 DÉTAILS DE LA COMMANDE FOURNISSEUR");
-    detailsTitle->setObjectName("titleLabel");
+    OliveraqTheme::apply(detailsTitle, OliveraqTheme::Titre);
     detailsTitle->setAlignment(Qt::AlignCenter);
 
     QScrollArea *scrollDetail = new QScrollArea(pageDetailsFournisseurs);
@@ -1474,11 +4197,15 @@ void MainWindow::setupUI()
     connect(searchFournisseurEdit, &QLineEdit::textChanged, this, &MainWindow::searchFournisseur);
     connect(comboSortFournisseurs, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::sortCommandesParNom);
     connect(btnExportPDF, &QPushButton::clicked, this, &MainWindow::exportFacturePDF);
+    connect(btnExportLot, &QPushButton::clicked, this, &MainWindow::exportFacturesLotFournisseurs);
     connect(editPrixHT, &QLineEdit::textChanged, this, &MainWindow::calculatePrixTTC);
     connect(editTVA, &QLineEdit::textChanged, this, &MainWindow::calculatePrixTTC);
     connect(editRemise, &QLineEdit::textChanged, this, &MainWindow::calculatePrixTTC);
     connect(editAvance, &QLineEdit::textChanged, this, &MainWindow::calculateResteAPayer);
+}
 
+void MainWindow::buildPageClients()
+{
     // ======================================
     // PAGE GESTION CLIENTS
     // ======================================
@@ -1489,23 +4216,23 @@ void MainWindow::setupUI()
 
     // Menu latéral gauche
     QFrame *menuFrameClients = new QFrame(pageClients);
-    menuFrameClients->setObjectName("menuFrame");
+    OliveraqTheme::apply(menuFrameClients, OliveraqTheme::PanneauLateral);
     menuFrameClients->setFixedWidth(250);
     QVBoxLayout *menuLayoutClients = new QVBoxLayout(menuFrameClients);
     menuLayoutClients->setContentsMargins(15, 30, 15, 20);
     menuLayoutClients->setSpacing(15);
 
     QLabel *titleMenuClients = new QLabel("GESTION CLIENTS", menuFrameClients);
-    titleMenuClients->setStyleSheet("color:white; font-size:18px; font-weight:bold;");
+    OliveraqTheme::apply(titleMenuClients, OliveraqTheme::TitreMenu);
     titleMenuClients->setAlignment(Qt::AlignCenter);
 
     btnListeClients = new QPushButton("📋 Liste des clients", menuFrameClients);
     btnAjouterClient = new QPushButton("➕ Ajouter client", menuFrameClients);
     btnRetourMenuClients = new QPushButton("🔙 Retour au menu", menuFrameClients);
 
-    btnListeClients->setStyleSheet(menuBtnStyle);
-    btnAjouterClient->setStyleSheet(menuBtnStyle);
-    btnRetourMenuClients->setStyleSheet(menuBtnStyle);
+    OliveraqTheme::apply(btnListeClients, OliveraqTheme::BoutonLateral);
+    OliveraqTheme::apply(btnAjouterClient, OliveraqTheme::BoutonLateral);
+    OliveraqTheme::apply(btnRetourMenuClients, OliveraqTheme::BoutonLateral);
 
     menuLayoutClients->addWidget(titleMenuClients);
     menuLayoutClients->addSpacing(20);
@@ -1528,7 +4255,7 @@ void MainWindow::setupUI()
     // Header avec recherche et tri
     QHBoxLayout *headerClientsLayout = new QHBoxLayout();
     QLabel *titleListeClients = new QLabel("📋 LISTE DES CLIENTS");
-    titleListeClients->setObjectName("titleLabel");
+    OliveraqTheme::apply(titleListeClients, OliveraqTheme::Titre);
 
     searchClientEdit = new QLineEdit(pageListeClients);
     searchClientEdit->setPlaceholderText("🔍 Rechercher par nom...");
@@ -1541,12 +4268,14 @@ void MainWindow::setupUI()
     comboSortClients->setFixedWidth(200);
 
     btnExportPDFClient = new QPushButton("📄 Exporter facture", pageListeClients);
+    btnExportLotClient = new QPushButton("🗂 Export groupé", pageListeClients);
 
     headerClientsLayout->addWidget(titleListeClients);
     headerClientsLayout->addStretch();
     headerClientsLayout->addWidget(searchClientEdit);
     headerClientsLayout->addWidget(comboSortClients);
     headerClientsLayout->addWidget(btnExportPDFClient);
+    headerClientsLayout->addWidget(btnExportLotClient);
 
     // Statistiques clients
     QHBoxLayout *statsClientsLayout = new QHBoxLayout();
@@ -1557,11 +4286,11 @@ void MainWindow::setupUI()
     labelCommandesLivreesClients = new QLabel("Livrées: 0");
     labelTauxLivraisonClients = new QLabel("Taux livraison: 0%");
 
-    labelTotalClients->setStyleSheet(statStyle);
-    labelTotalCommandesClients->setStyleSheet(statStyle);
-    labelCommandesEnCoursClients->setStyleSheet(statStyle);
-    labelCommandesLivreesClients->setStyleSheet(statStyle);
-    labelTauxLivraisonClients->setStyleSheet(statStyle);
+    OliveraqTheme::apply(labelTotalClients, OliveraqTheme::Indicateur);
+    OliveraqTheme::apply(labelTotalCommandesClients, OliveraqTheme::Indicateur);
+    OliveraqTheme::apply(labelCommandesEnCoursClients, OliveraqTheme::Indicateur);
+    OliveraqTheme::apply(labelCommandesLivreesClients, OliveraqTheme::Indicateur);
+    OliveraqTheme::apply(labelTauxLivraisonClients, OliveraqTheme::Indicateur);
 
     statsClientsLayout->addWidget(labelTotalClients);
     statsClientsLayout->addWidget(labelTotalCommandesClients);
@@ -1573,13 +4302,9 @@ void MainWindow::setupUI()
     chartClients = new PieChartWidget(pageListeClients);
 
     // Table clients
-    tableClients = new QTableWidget(pageListeClients);
-    tableClients->setColumnCount(12);
-    tableClients->setHorizontalHeaderLabels({
-        "ID", "Nom", "Email", "Téléphone", "Produit",
-        "Date commande", "Date livraison", "Prix HT",
-        "Mode paiement", "Statut", "Quantité", "Prix TTC"
-    });
+    tableClients = new QTableView(pageListeClients);
+    tableClients->setModel(filtreClients);
+    configurerTableVirtuelle(tableClients);
     tableClients->setEditTriggers(QAbstractItemView::NoEditTriggers);
     tableClients->setSelectionBehavior(QAbstractItemView::SelectRows);
     tableClients->setAlternatingRowColors(true);
@@ -1598,17 +4323,48 @@ void MainWindow::setupUI()
 
     // Performance clients
     QLabel *perfTitleClients = new QLabel("📊 Performance des clients");
-    perfTitleClients->setObjectName("titleLabel");
+    OliveraqTheme::apply(perfTitleClients, OliveraqTheme::Titre);
 
-    tablePerformanceClients = new QTableWidget(pageListeClients);
-    tablePerformanceClients->setColumnCount(4);
-    tablePerformanceClients->setHorizontalHeaderLabels({"Nom client", "Commandes totales", "Commandes livrées", "Taux (%)"});
+    tablePerformanceClients = new QTableView(pageListeClients);
+    tablePerformanceClients->setModel(modelePerformanceClients);
+    configurerTableVirtuelle(tablePerformanceClients);
     tablePerformanceClients->setMaximumHeight(150);
     tablePerformanceClients->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
 
     labelMeilleurClient = new QLabel("🏆 Meilleur client: -");
     labelClientRapide = new QLabel("⚡ Client le plus rapide: -");
 
+    // Classement des clients (top 10) selon le critère choisi
+    QHBoxLayout *classementClientsLayout = new QHBoxLayout();
+    QLabel *labelClassementClients = new QLabel("Classer les clients par :");
+    comboClassementClients = new QComboBox(pageListeClients);
+    comboClassementClients->addItem("Chiffre d'affaires", ClientRevenueIndex::ChiffreAffaires);
+    comboClassementClients->addItem("Nombre de commandes", ClientRevenueIndex::NombreCommandes);
+    comboClassementClients->addItem("Panier moyen", ClientRevenueIndex::PanierMoyen);
+    classementClientsLayout->addWidget(labelClassementClients);
+    classementClientsLayout->addWidget(comboClassementClients);
+    classementClientsLayout->addStretch();
+
+    tableClassementClients = new QTableWidget(pageListeClients);
+    tableClassementClients->setColumnCount(5);
+    tableClassementClients->setHorizontalHeaderLabels({"Rang", "Client", "Chiffre d'affaires TTC (DT)", "Commandes", "Panier moyen (DT)"});
+    tableClassementClients->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableClassementClients->verticalHeader()->setVisible(false);
+    tableClassementClients->setMaximumHeight(150);
+    tableClassementClients->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    // Créances clients (reste à payer) par ancienneté
+    QLabel *encoursTitleClients = new QLabel("💰 Reste à encaisser des clients par ancienneté");
+    OliveraqTheme::apply(encoursTitleClients, OliveraqTheme::Titre);
+
+    tableEncoursClients = new QTableWidget(pageListeClients);
+    tableEncoursClients->setColumnCount(6);
+    tableEncoursClients->setHorizontalHeaderLabels({"Client", "0-30 j", "31-60 j", "61-90 j", "+90 j", "Total (DT)"});
+    tableEncoursClients->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableEncoursClients->verticalHeader()->setVisible(false);
+    tableEncoursClients->setMaximumHeight(150);
+    tableEncoursClients->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
     listeClientsLayout->addLayout(headerClientsLayout);
     listeClientsLayout->addLayout(statsClientsLayout);
     listeClientsLayout->addWidget(chartClients);
@@ -1618,6 +4374,14 @@ void MainWindow::setupUI()
     listeClientsLayout->addWidget(tablePerformanceClients);
     listeClientsLayout->addWidget(labelMeilleurClient);
     listeClientsLayout->addWidget(labelClientRapide);
+    listeClientsLayout->addLayout(classementClientsLayout);
+    listeClientsLayout->addWidget(tableClassementClients);
+    listeClientsLayout->addWidget(encoursTitleClients);
+    listeClientsLayout->addWidget(tableEncoursClients);
+
+    connect(comboClassementClients, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int) {
+        updateClassementClients();
+    });
 
     stackedWidgetClients->addWidget(pageListeClients);
 
@@ -1630,7 +4394,7 @@ void MainWindow::setupUI()
     formClientsLayout->setSpacing(15);
 
     QLabel *titleFormClient = new QLabel("➕ AJOUTER/MODIFIER CLIENT");
-    titleFormClient->setObjectName("titleLabel");
+    OliveraqTheme::apply(titleFormClient, OliveraqTheme::Titre);
     titleFormClient->setAlignment(Qt::AlignCenter);
 
     QScrollArea *scrollClient = new QScrollArea(pageFormulaireClients);
@@ -1644,7 +4408,8 @@ void MainWindow::setupUI()
 
     // Informations client
     QLabel *infoClientLabel = new QLabel("Informations du client");
-    infoClientLabel->setStyleSheet("font-size: 16px; font-weight: bold; color: #556b2f; margin-top: 10px;");
+    OliveraqTheme::apply(infoClientLabel, OliveraqTheme::SousSection);
+    infoClientLabel->setContentsMargins(0, 10, 0, 0);
 
     editNomClient = new QLineEdit();
     editEmailClient = new QLineEdit();
@@ -1653,7 +4418,8 @@ void MainWindow::setupUI()
 
     // Informations commande
     QLabel *infoCommandeClientLabel = new QLabel("Informations de la commande");
-    infoCommandeClientLabel->setStyleSheet("font-size: 16px; font-weight: bold; color: #556b2f; margin-top: 10px;");
+    OliveraqTheme::apply(infoCommandeClientLabel, OliveraqTheme::SousSection);
+    infoCommandeClientLabel->setContentsMargins(0, 10, 0, 0);
 
     editIDCommandeClient = new QLineEdit();
     editIDCommandeClient->setReadOnly(true);
@@ -1733,7 +4499,7 @@ void MainWindow::setupUI()
     detailsClientsLayout->setSpacing(15);
 
     detailsTitleClient = new QLabel("📄 DÉTAILS DE LA COMMANDE CLIENT");
-    detailsTitleClient->setObjectName("titleLabel");
+    OliveraqTheme::apply(detailsTitleClient, OliveraqTheme::Titre);
     detailsTitleClient->setAlignment(Qt::AlignCenter);
 
     QScrollArea *scrollDetailClient = new QScrollArea(pageDetailsClients);
@@ -1823,27 +4589,20 @@ void MainWindow::setupUI()
     connect(searchClientEdit, &QLineEdit::textChanged, this, &MainWindow::searchClient);
     connect(comboSortClients, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::sortCommandesClients);
     connect(btnExportPDFClient, &QPushButton::clicked, this, &MainWindow::exportFactureClientPDF);
+    connect(btnExportLotClient, &QPushButton::clicked, this, &MainWindow::exportFacturesLotClients);
     connect(editPrixHTClient, &QLineEdit::textChanged, this, &MainWindow::calculatePrixTTCClient);
     connect(editTVAClient, &QLineEdit::textChanged, this, &MainWindow::calculatePrixTTCClient);
     connect(editRemiseClient, &QLineEdit::textChanged, this, &MainWindow::calculatePrixTTCClient);
     connect(editAvanceClient, &QLineEdit::textChanged, this, &MainWindow::calculateResteAPayerClient);
+}
 
+void MainWindow::buildPageStocks()
+{
     // ======================================
     // PAGE GESTION DE STOCK (PRODUCTION)
     // ======================================
     pageStocks = new QWidget(this);
-    pageStocks->setStyleSheet(
-        "QMainWindow { background-color: #2d5016; }"
-        "QPushButton { background-color: #5c7a3a; color: white; padding: 12px; border-radius: 4px; font-size: 14px; font-weight: bold; text-align: left; }"
-        "QPushButton:hover { background-color: #6b8a4a; }"
-        "QPushButton:pressed { background-color: #4a6a2a; }"
-        "QPushButton#btnModifierStock, QPushButton#btnSupprimerStock, QPushButton#btnDetailsStock { background-color: #5c7a3a; color: white; padding: 10px 20px; border-radius: 4px; font-size: 14px; font-weight: bold; min-width: 100px; border: 1px solid #4a6a2a; }"
-        "QPushButton#btnModifierStock:hover, QPushButton#btnSupprimerStock:hover, QPushButton#btnDetailsStock:hover { background-color: #6b8a4a; }"
-        "QLabel { color: #1a3009; font-weight: bold; font-size: 12px; }"
-        "QLineEdit, QDateEdit, QComboBox, QSpinBox, QDoubleSpinBox { background-color: white; border: 1px solid #5f6f3e; border-radius: 4px; padding: 5px; font-size: 12px; }"
-        "QTableWidget { background-color: white; gridline-color: #d0d0d0; border: 1px solid #5f6f3e; gridline-width: 0px; }"
-        "QHeaderView::section { background-color: #87CEEB; color: #1a3009; padding: 6px; font-weight: bold; font-size: 10px; border: none; }"
-    );
+    OliveraqTheme::apply(pageStocks, OliveraqTheme::PageStock);
 
     QHBoxLayout *stocksMainLayout = new QHBoxLayout(pageStocks);
     stocksMainLayout->setContentsMargins(0, 0, 0, 0);
@@ -1851,24 +4610,18 @@ void MainWindow::setupUI()
 
     // Main splitter (horizontal: liste à gauche, stats+formulaire à droite)
     mainSplitterStock = new QSplitter(Qt::Horizontal, pageStocks);
-    mainSplitterStock->setStyleSheet(
-        "QSplitter::handle { background-color: transparent; width: 0px; }"
-        "QSplitter::handle:horizontal { width: 0px; }"
-    );
+    mainSplitterStock->setHandleWidth(0);
 
     // Section liste (gauche)
     sectionListeStock = new QWidget(mainSplitterStock);
-    sectionListeStock->setStyleSheet(
-        "background-color: #f5f5dc;"
-        "QPushButton#btnModifierStock:hover, QPushButton#btnSupprimerStock:hover, QPushButton#btnDetailsStock:hover { background-color: #6b8a4a; }"
-    );
+    OliveraqTheme::apply(sectionListeStock, OliveraqTheme::PageStock);
 
     QVBoxLayout *listeStockLayout = new QVBoxLayout(sectionListeStock);
     listeStockLayout->setContentsMargins(20, 20, 20, 20);
     listeStockLayout->setSpacing(15);
 
     QLabel *titleLabelStock = new QLabel("Liste des productions", sectionListeStock);
-    titleLabelStock->setStyleSheet("font-size: 20px; font-weight: bold; color: #4a6a2a;");
+    OliveraqTheme::apply(titleLabelStock, OliveraqTheme::Titre);
 
     // Recherche et tri
     QHBoxLayout *searchLayoutStock = new QHBoxLayout();
@@ -1892,17 +4645,15 @@ void MainWindow::setupUI()
     searchLayoutStock->addWidget(comboTriStock);
 
     // Table
-    tableProductions = new QTableWidget(sectionListeStock);
-    tableProductions->setColumnCount(9);
-    tableProductions->setHorizontalHeaderLabels({
-        "ID", "Identifiant", "Date production", "Type produit",
-        "Qte matière (KG)", "Qte produite (L)", "Rendement (%)", "Lot", "Qualité"
-    });
+    tableProductions = new QTableView(sectionListeStock);
+    tableProductions->setModel(filtreProductions);
+    configurerTableVirtuelle(tableProductions);
     tableProductions->setEditTriggers(QAbstractItemView::NoEditTriggers);
     tableProductions->setSelectionBehavior(QAbstractItemView::SelectRows);
     tableProductions->setAlternatingRowColors(true);
     tableProductions->horizontalHeader()->setVisible(true);
     tableProductions->verticalHeader()->setVisible(false);
+    tableProductions->setItemDelegateForColumn(0, new OrdinalDelegate(tableProductions));
     
     // Set column widths to ensure text is fully visible
     tableProductions->setColumnWidth(0, 50);   // ID
@@ -1917,24 +4668,24 @@ void MainWindow::setupUI()
     
     // Enable horizontal scrolling if needed
     tableProductions->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
-    tableProductions->setRowCount(0);
 
     // Boutons d'action
     QHBoxLayout *btnStockLayout = new QHBoxLayout();
     btnModifierStock = new QPushButton("✏️ Modifier", sectionListeStock);
-    btnModifierStock->setObjectName("btnModifierStock");
-    btnModifierStock->setStyleSheet("background-color: #5c7a3a; color: white; padding: 10px 20px; border-radius: 4px; font-size: 14px; font-weight: bold; min-width: 100px; border: 1px solid #4a6a2a;");
+    OliveraqTheme::apply(btnModifierStock, OliveraqTheme::BoutonStock);
+    btnModifierStock->setMinimumWidth(100);
     
     btnSupprimerStock = new QPushButton("🗑️ Supprimer", sectionListeStock);
-    btnSupprimerStock->setObjectName("btnSupprimerStock");
-    btnSupprimerStock->setStyleSheet("background-color: #5c7a3a; color: white; padding: 10px 20px; border-radius: 4px; font-size: 14px; font-weight: bold; min-width: 100px; border: 1px solid #4a6a2a;");
+    OliveraqTheme::apply(btnSupprimerStock, OliveraqTheme::BoutonStock);
+    btnSupprimerStock->setMinimumWidth(100);
     
     btnDetailsStock = new QPushButton("📄 Détails", sectionListeStock);
-    btnDetailsStock->setObjectName("btnDetailsStock");
-    btnDetailsStock->setStyleSheet("background-color: #5c7a3a; color: white; padding: 10px 20px; border-radius: 4px; font-size: 14px; font-weight: bold; min-width: 100px; border: 1px solid #4a6a2a;");
+    OliveraqTheme::apply(btnDetailsStock, OliveraqTheme::BoutonStock);
+    btnDetailsStock->setMinimumWidth(100);
     
     btnExportPDFStock = new QPushButton("📄 Exporter PDF", sectionListeStock);
-    btnExportPDFStock->setStyleSheet("background-color: #5c7a3a; color: white; padding: 10px 20px; border-radius: 4px; font-size: 14px; font-weight: bold; min-width: 150px; border: 1px solid #4a6a2a;");
+    OliveraqTheme::apply(btnExportPDFStock, OliveraqTheme::BoutonStock);
+    btnExportPDFStock->setMinimumWidth(150);
 
     btnStockLayout->addWidget(btnModifierStock);
     btnStockLayout->addWidget(btnSupprimerStock);
@@ -1943,7 +4694,8 @@ void MainWindow::setupUI()
 
     QHBoxLayout *btnAjouterLayoutStock = new QHBoxLayout();
     btnAjouterListeStock = new QPushButton("➕ Ajouter", sectionListeStock);
-    btnAjouterListeStock->setStyleSheet("background-color: #5c7a3a; color: white; padding: 10px 20px; border-radius: 4px; font-size: 14px; font-weight: bold; min-width: 100px; border: 1px solid #4a6a2a;");
+    OliveraqTheme::apply(btnAjouterListeStock, OliveraqTheme::BoutonStock);
+    btnAjouterListeStock->setMinimumWidth(100);
     btnAjouterLayoutStock->addWidget(btnAjouterListeStock);
     btnAjouterLayoutStock->addStretch();
 
@@ -1955,21 +4707,22 @@ void MainWindow::setupUI()
 
     // Right splitter (vertical: stats en haut, formulaire en bas)
     rightSplitterStock = new QSplitter(Qt::Vertical, mainSplitterStock);
-    rightSplitterStock->setStyleSheet(
-        "QSplitter::handle { background-color: transparent; height: 0px; }"
-        "QSplitter::handle:vertical { height: 0px; }"
-    );
+    rightSplitterStock->setHandleWidth(0);
+
+    // Section statistiques (défilante : camembert, cube, courbes, rendements)
+    QScrollArea *scrollStatistiquesStock = new QScrollArea(rightSplitterStock);
+    scrollStatistiquesStock->setWidgetResizable(true);
+    scrollStatistiquesStock->setFrameShape(QFrame::NoFrame);
 
-    // Section statistiques
-    sectionStatistiquesStock = new QWidget(rightSplitterStock);
-    sectionStatistiquesStock->setStyleSheet("background-color: #f5f5dc;");
+    sectionStatistiquesStock = new QWidget();
+    OliveraqTheme::apply(sectionStatistiquesStock, OliveraqTheme::PageStock);
 
     QVBoxLayout *statsLayoutStock = new QVBoxLayout(sectionStatistiquesStock);
     statsLayoutStock->setContentsMargins(15, 15, 15, 15);
     statsLayoutStock->setSpacing(10);
 
     QLabel *titleLabelStatsStock = new QLabel("📊 Statistiques de production", sectionStatistiquesStock);
-    titleLabelStatsStock->setStyleSheet("font-size: 16px; font-weight: bold; color: #4a6a2a;");
+    OliveraqTheme::apply(titleLabelStatsStock, OliveraqTheme::TitreSection);
 
     pieChartContainerStock = new QWidget(sectionStatistiquesStock);
     pieChartContainerStock->setMinimumHeight(200);
@@ -1978,19 +4731,101 @@ void MainWindow::setupUI()
     chartLayoutStock->setContentsMargins(0, 0, 0, 0);
     chartLayoutStock->addWidget(pieChartWidgetStock);
 
+    // Cube de production : on choisit l'axe, double-clic pour détailler
+    QHBoxLayout *cubeControlsLayoutStock = new QHBoxLayout();
+    QLabel *labelCubeAxeStock = new QLabel("Détailler par :", sectionStatistiquesStock);
+    comboCubeAxeStock = new QComboBox(sectionStatistiquesStock);
+    comboCubeAxeStock->addItem("Type produit", ProductionCube::DimType);
+    comboCubeAxeStock->addItem("Mois", ProductionCube::DimMois);
+    comboCubeAxeStock->addItem("Qualité", ProductionCube::DimQualite);
+    btnCubeRemonterStock = new QPushButton("⬆ Remonter", sectionStatistiquesStock);
+    btnCubeRemonterStock->setEnabled(false);
+    OliveraqTheme::apply(btnCubeRemonterStock, OliveraqTheme::BoutonStock);
+    labelCubeCheminStock = new QLabel("Toutes les productions", sectionStatistiquesStock);
+    OliveraqTheme::apply(labelCubeCheminStock, OliveraqTheme::Annotation);
+
+    cubeControlsLayoutStock->addWidget(labelCubeAxeStock);
+    cubeControlsLayoutStock->addWidget(comboCubeAxeStock);
+    cubeControlsLayoutStock->addWidget(btnCubeRemonterStock);
+    cubeControlsLayoutStock->addWidget(labelCubeCheminStock, 1);
+
+    tableCubeStock = new QTableWidget(sectionStatistiquesStock);
+    tableCubeStock->setColumnCount(5);
+    tableCubeStock->setHorizontalHeaderLabels({"Membre", "Productions", "Matière (KG)", "Produit (L)", "Rendement moyen"});
+    tableCubeStock->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableCubeStock->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tableCubeStock->verticalHeader()->setVisible(false);
+    tableCubeStock->setMaximumHeight(180);
+    tableCubeStock->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
     statsLayoutStock->addWidget(titleLabelStatsStock);
     statsLayoutStock->addWidget(pieChartContainerStock);
+    statsLayoutStock->addLayout(cubeControlsLayoutStock);
+    statsLayoutStock->addWidget(tableCubeStock);
+
+    // Courbes des volumes reçus (KG) et produits (L)
+    QHBoxLayout *courbesLayoutStock = new QHBoxLayout();
+    QLabel *labelCourbesStock = new QLabel("📈 Volumes par :", sectionStatistiquesStock);
+    OliveraqTheme::apply(labelCourbesStock, OliveraqTheme::LibelleSection);
+    comboGranulariteStock = new QComboBox(sectionStatistiquesStock);
+    comboGranulariteStock->addItem("Jour", ProductionTimeSeries::Jour);
+    comboGranulariteStock->addItem("Semaine", ProductionTimeSeries::Semaine);
+    comboGranulariteStock->addItem("Mois", ProductionTimeSeries::Mois);
+    comboGranulariteStock->setCurrentIndex(ProductionTimeSeries::Mois);
+    courbesLayoutStock->addWidget(labelCourbesStock);
+    courbesLayoutStock->addWidget(comboGranulariteStock);
+    courbesLayoutStock->addStretch();
+
+    lineChartWidgetStock = new LineChartWidget(sectionStatistiquesStock);
+    lineChartWidgetStock->setMinimumHeight(180);
+
+    statsLayoutStock->addLayout(courbesLayoutStock);
+    statsLayoutStock->addWidget(lineChartWidgetStock);
+
+    // Analyse des rendements : histogramme, statistiques par type et mois, lots atypiques
+    QLabel *labelRendementsStock = new QLabel("🧪 Analyse des rendements (KG/L)", sectionStatistiquesStock);
+    OliveraqTheme::apply(labelRendementsStock, OliveraqTheme::LibelleSection);
+
+    histogramRendementStock = new HistogramWidget(sectionStatistiquesStock);
+    histogramRendementStock->setMinimumHeight(140);
+
+    tableRendementsStock = new QTableWidget(sectionStatistiquesStock);
+    tableRendementsStock->setColumnCount(5);
+    tableRendementsStock->setHorizontalHeaderLabels({"Type", "Mois", "Lots", "Moyenne", "Écart-type"});
+    tableRendementsStock->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableRendementsStock->verticalHeader()->setVisible(false);
+    tableRendementsStock->setMaximumHeight(160);
+    tableRendementsStock->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    QLabel *labelLotsAtypiquesStock = new QLabel("⚠️ Lots atypiques (z-score robuste > 3,5)", sectionStatistiquesStock);
+    OliveraqTheme::apply(labelLotsAtypiquesStock, OliveraqTheme::LibelleSection);
+
+    tableLotsAtypiquesStock = new QTableWidget(sectionStatistiquesStock);
+    tableLotsAtypiquesStock->setColumnCount(5);
+    tableLotsAtypiquesStock->setHorizontalHeaderLabels({"Identifiant", "Type", "Date", "Rendement", "z robuste"});
+    tableLotsAtypiquesStock->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableLotsAtypiquesStock->verticalHeader()->setVisible(false);
+    tableLotsAtypiquesStock->setMaximumHeight(140);
+    tableLotsAtypiquesStock->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    statsLayoutStock->addWidget(labelRendementsStock);
+    statsLayoutStock->addWidget(histogramRendementStock);
+    statsLayoutStock->addWidget(tableRendementsStock);
+    statsLayoutStock->addWidget(labelLotsAtypiquesStock);
+    statsLayoutStock->addWidget(tableLotsAtypiquesStock);
+
+    scrollStatistiquesStock->setWidget(sectionStatistiquesStock);
 
     // Section formulaire
     sectionFormulaireStock = new QWidget(rightSplitterStock);
-    sectionFormulaireStock->setStyleSheet("background-color: #f5f5dc;");
+    OliveraqTheme::apply(sectionFormulaireStock, OliveraqTheme::PageStock);
 
     QVBoxLayout *formLayoutStock = new QVBoxLayout(sectionFormulaireStock);
     formLayoutStock->setContentsMargins(30, 30, 30, 30);
     formLayoutStock->setSpacing(15);
 
     QLabel *titleLabelFormStock = new QLabel("➕ Ajouter/Modifier Production", sectionFormulaireStock);
-    titleLabelFormStock->setStyleSheet("font-size: 18px; font-weight: bold; color: #4a6a2a;");
+    OliveraqTheme::apply(titleLabelFormStock, OliveraqTheme::TitreSection);
 
     QFormLayout *fieldsLayoutStock = new QFormLayout();
     fieldsLayoutStock->setHorizontalSpacing(10);
@@ -2056,12 +4891,14 @@ void MainWindow::setupUI()
     
     // Bouton Calculer rendement
     btnCalculerRendementStock = new QPushButton("Calculer rendement", sectionFormulaireStock);
-    btnCalculerRendementStock->setStyleSheet("background-color: #5c7a3a; color: white; padding: 12px 24px; border-radius: 4px; font-size: 14px; font-weight: bold; min-width: 220px; min-height: 40px; border: 1px solid #4a6a2a;");
+    OliveraqTheme::apply(btnCalculerRendementStock, OliveraqTheme::BoutonStock);
+    btnCalculerRendementStock->setMinimumSize(220, 40);
     btnFormLayoutStock->addWidget(btnCalculerRendementStock);
     
     // Bouton Enregistrer
     btnEnregistrerStock = new QPushButton("💾 Enregistrer", sectionFormulaireStock);
-    btnEnregistrerStock->setStyleSheet("background-color: #5c7a3a; color: white; padding: 12px 24px; border-radius: 4px; font-size: 14px; font-weight: bold; min-width: 180px; min-height: 40px; border: 1px solid #4a6a2a;");
+    OliveraqTheme::apply(btnEnregistrerStock, OliveraqTheme::BoutonStock);
+    btnEnregistrerStock->setMinimumSize(180, 40);
     btnFormLayoutStock->addWidget(btnEnregistrerStock);
 
     fieldsLayoutStock->addRow("", btnFormLayoutStock);
@@ -2071,7 +4908,7 @@ void MainWindow::setupUI()
     formLayoutStock->addStretch();
 
     // Assembler les splitters
-    rightSplitterStock->addWidget(sectionStatistiquesStock);
+    rightSplitterStock->addWidget(scrollStatistiquesStock);
     rightSplitterStock->addWidget(sectionFormulaireStock);
     mainSplitterStock->addWidget(sectionListeStock);
     mainSplitterStock->addWidget(rightSplitterStock);
@@ -2100,38 +4937,88 @@ void MainWindow::setupUI()
     connect(comboRechercheTypeStock, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::on_comboRechercheTypeStock_currentIndexChanged);
     connect(comboTriStock, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::on_comboTriStock_currentIndexChanged);
     connect(comboTypeProduitStock, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::on_comboTypeProduitStock_currentIndexChanged);
+    connect(comboCubeAxeStock, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::on_comboCubeAxeStock_currentIndexChanged);
+    connect(tableCubeStock, &QTableWidget::cellDoubleClicked, this, &MainWindow::on_tableCubeStock_cellDoubleClicked);
+    connect(btnCubeRemonterStock, &QPushButton::clicked, this, &MainWindow::on_btnCubeRemonterStock_clicked);
+    connect(comboGranulariteStock, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::on_comboGranulariteStock_currentIndexChanged);
 
     // Initialiser les statistiques
     QTimer::singleShot(0, this, [this]() {
-        genererStatistiquesStock();
+        rebuildProductionAnalyticsAsync();
     });
+}
+
+void MainWindow::buildPageVentes()
+{
+    // ======================================
+    // PAGE GESTION DES VENTES (TABLEAU DE BORD)
+    // ======================================
+    pageVentes = new QWidget(this);
+    OliveraqTheme::apply(pageVentes, OliveraqTheme::PageStock);
+
+    QVBoxLayout *ventesLayout = new QVBoxLayout(pageVentes);
+    ventesLayout->setContentsMargins(20, 20, 20, 20);
+    ventesLayout->setSpacing(15);
+
+    QHBoxLayout *headerVentesLayout = new QHBoxLayout();
+    QLabel *titleVentes = new QLabel("💹 TABLEAU DE BORD DES VENTES", pageVentes);
+    OliveraqTheme::apply(titleVentes, OliveraqTheme::Titre);
+    btnRetourMenuVentes = new QPushButton("🔙 Retour au menu", pageVentes);
+    OliveraqTheme::apply(btnRetourMenuVentes, OliveraqTheme::BoutonStock);
+    headerVentesLayout->addWidget(titleVentes);
+    headerVentesLayout->addStretch();
+    headerVentesLayout->addWidget(btnRetourMenuVentes);
+
+    // Indicateurs
+    QHBoxLayout *kpiVentesLayout = new QHBoxLayout();
+    labelVentesCA = new QLabel("Chiffre d'affaires: 0.00 DT TTC", pageVentes);
+    labelVentesMarge = new QLabel("Marge: 0.00 DT", pageVentes);
+    labelVentesEncaisse = new QLabel("Encaissé: 0.00 DT", pageVentes);
+    labelVentesReste = new QLabel("Reste à encaisser: 0.00 DT", pageVentes);
+    for (QLabel *kpi : {labelVentesCA, labelVentesMarge, labelVentesEncaisse, labelVentesReste}) {
+        OliveraqTheme::apply(kpi, OliveraqTheme::Indicateur);
+        kpiVentesLayout->addWidget(kpi);
+    }
+
+    QLabel *titleVentesJour = new QLabel("📈 Chiffre d'affaires par jour", pageVentes);
+    chartVentesJour = new LineChartWidget(pageVentes);
+    chartVentesJour->setMinimumHeight(220);
+    chartVentesJour->setEmptyText("Aucune vente enregistrée.");
+
+    QLabel *titleTopProduits = new QLabel("🏆 Meilleurs produits", pageVentes);
+    tableTopProduits = new QTableWidget(pageVentes);
+    tableTopProduits->setColumnCount(6);
+    tableTopProduits->setHorizontalHeaderLabels({"Produit", "Commandes", "Quantité", "Ventes TTC (DT)", "Achats HT (DT)", "Marge HT (DT)"});
+    tableTopProduits->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableTopProduits->verticalHeader()->setVisible(false);
+    tableTopProduits->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    ventesLayout->addLayout(headerVentesLayout);
+    ventesLayout->addLayout(kpiVentesLayout);
+    ventesLayout->addWidget(titleVentesJour);
+    ventesLayout->addWidget(chartVentesJour);
+    ventesLayout->addWidget(titleTopProduits);
+    ventesLayout->addWidget(tableTopProduits);
+
+    mainStack->addWidget(pageVentes);
+
+    connect(btnRetourMenuVentes, &QPushButton::clicked, this, &MainWindow::backToMenu);
+}
 
+void MainWindow::buildPageQuiz()
+{
     // ======================================
     // PAGE QUIZ
     // ======================================
     pageQuiz = new QWidget(this);
-    pageQuiz->setStyleSheet(
-        "QWidget { "
-        "background: qlineargradient(x1:0, y1:0, x2:1, y2:1, "
-        "stop:0 #556b2f, "
-        "stop:0.25 #6b8e23, "
-        "stop:0.5 #808000, "
-        "stop:0.75 #6b8e23, "
-        "stop:1 #556b2f); "
-        "}"
-        );
+    OliveraqTheme::apply(pageQuiz, OliveraqTheme::PageDegradee);
 
     QVBoxLayout *quizLayout = new QVBoxLayout(pageQuiz);
     quizLayout->setContentsMargins(60, 40, 60, 40);
     quizLayout->setSpacing(20);
 
     QWidget *quizContainer = new QWidget(pageQuiz);
-    quizContainer->setStyleSheet(
-        "QWidget { "
-        "background-color: #ffffff; "
-        "border-radius: 12px; "
-        "}"
-        );
+    OliveraqTheme::apply(quizContainer, OliveraqTheme::Carte);
     quizContainer->setMaximumWidth(900);
 
     QVBoxLayout *containerQuizLayout = new QVBoxLayout(quizContainer);
@@ -2140,14 +5027,8 @@ void MainWindow::setupUI()
 
     quizTitle = new QLabel("🎓 Quiz pédagogique OLIVERAQ");
     quizTitle->setAlignment(Qt::AlignCenter);
-    quizTitle->setStyleSheet(
-        "QLabel { "
-        "font-size: 26px; "
-        "font-weight: 600; "
-        "color: #556b2f; "
-        "margin-bottom: 10px; "
-        "}"
-        );
+    OliveraqTheme::apply(quizTitle, OliveraqTheme::TitreCarte);
+    quizTitle->setContentsMargins(0, 0, 0, 10);
 
     quizIntro = new QLabel(
         "Testez vos connaissances sur OLIVERAQ et découvrez "
@@ -2155,80 +5036,30 @@ void MainWindow::setupUI()
         );
     quizIntro->setAlignment(Qt::AlignCenter);
     quizIntro->setWordWrap(true);
-    quizIntro->setStyleSheet(
-        "QLabel { "
-        "font-size: 14px; "
-        "color: #6b8e23; "
-        "margin-bottom: 20px; "
-        "}"
-        );
+    OliveraqTheme::apply(quizIntro, OliveraqTheme::SousTitreCarte);
+    quizIntro->setContentsMargins(0, 0, 0, 20);
 
     quizProgressLabel = new QLabel("Question 1 / 5");
     quizProgressLabel->setAlignment(Qt::AlignCenter);
-    quizProgressLabel->setStyleSheet(
-        "QLabel { "
-        "font-size: 13px; "
-        "font-weight: 500; "
-        "color: #808000; "
-        "margin-bottom: 15px; "
-        "}"
-        );
+    OliveraqTheme::apply(quizProgressLabel, OliveraqTheme::Progression);
+    quizProgressLabel->setContentsMargins(0, 0, 0, 15);
 
     quizQuestionLabel = new QLabel();
     quizQuestionLabel->setAlignment(Qt::AlignLeft);
     quizQuestionLabel->setWordWrap(true);
-    quizQuestionLabel->setStyleSheet(
-        "QLabel { "
-        "font-size: 16px; "
-        // =======================
-        // CONTINUATION OF MAINWINDOW.CPP
-        // Add this after the Quiz page setup in setupUI()
-        // =======================
-
-        "font-weight: 500; "
-        "color: #2c3e50; "
-        "padding: 15px; "
-        "background-color: #f9f9f9; "
-        "border-radius: 8px; "
-        "margin-bottom: 20px; "
-        "}"
-        );
+    OliveraqTheme::apply(quizQuestionLabel, OliveraqTheme::Enonce);
 
     quizOption1 = new QRadioButton();
     quizOption2 = new QRadioButton();
     quizOption3 = new QRadioButton();
 
-    QString radioStyle =
-        "QRadioButton { "
-        "font-size: 14px; "
-        "color: #2c3e50; "
-        "padding: 10px; "
-        "}"
-        "QRadioButton::indicator { "
-        "width: 18px; "
-        "height: 18px; "
-        "}"
-        "QRadioButton::indicator:checked { "
-        "background-color: #6b8e23; "
-        "border: 2px solid #556b2f; "
-        "border-radius: 9px; "
-        "}";
-
-    quizOption1->setStyleSheet(radioStyle);
-    quizOption2->setStyleSheet(radioStyle);
-    quizOption3->setStyleSheet(radioStyle);
+    for (QRadioButton *option : {quizOption1, quizOption2, quizOption3})
+        OliveraqTheme::apply(option, OliveraqTheme::Option);
 
     quizFeedbackLabel = new QLabel();
     quizFeedbackLabel->setAlignment(Qt::AlignCenter);
     quizFeedbackLabel->setWordWrap(true);
-    quizFeedbackLabel->setStyleSheet(
-        "QLabel { "
-        "font-size: 13px; "
-        "padding: 12px; "
-        "border-radius: 6px; "
-        "margin-top: 10px; "
-        "}"
-        );
+    OliveraqTheme::apply(quizFeedbackLabel, OliveraqTheme::Retour);
     quizFeedbackLabel->hide();
 
     QHBoxLayout *btnQuizLayout = new QHBoxLayout();
@@ -2236,40 +5067,12 @@ void MainWindow::setupUI()
     btnQuizRestart = new QPushButton("Recommencer");
     btnQuizBackToMenu = new QPushButton("Retour au menu");
 
-    btnQuizNext->setStyleSheet(
-        "QPushButton { "
-        "font-size: 14px; "
-        "font-weight: 600; "
-        "color: #ffffff; "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #6b8e23, stop:1 #556b2f); "
-        "border: none; "
-        "border-radius: 6px; "
-        "padding: 12px 30px; "
-        "min-width: 120px; "
-        "}"
-        "QPushButton:hover { "
-        "background: qlineargradient(x1:0, y1:0, x2:0, y2:1, "
-        "stop:0 #7a9e2d, stop:1 #6b8e23); "
-        "}"
-        );
+    OliveraqTheme::apply(btnQuizNext, OliveraqTheme::BoutonPrincipal);
+    OliveraqTheme::apply(btnQuizRestart, OliveraqTheme::BoutonPrincipal);
+    OliveraqTheme::apply(btnQuizBackToMenu, OliveraqTheme::BoutonSecondaire);
+    for (QPushButton *button : {btnQuizNext, btnQuizRestart, btnQuizBackToMenu})
+        button->setMinimumWidth(120);
 
-    btnQuizRestart->setStyleSheet(btnQuizNext->styleSheet());
-    btnQuizBackToMenu->setStyleSheet(
-        "QPushButton { "
-        "font-size: 14px; "
-        "font-weight: 600; "
-        "color: #556b2f; "
-        "background-color: #ffffff; "
-        "border: 2px solid #6b8e23; "
-        "border-radius: 6px; "
-        "padding: 12px 30px; "
-        "min-width: 120px; "
-        "}"
-        "QPushButton:hover { "
-        "background-color: #fafff0; "
-        "}"
-        );
 
     btnQuizRestart->hide();
 
@@ -2303,19 +5106,301 @@ void MainWindow::setupUI()
     initializeQuiz();
 }
 
+// =======================
+// IMPLÉMENTATION - RAPPORTS PDF
+// =======================
+void MainWindow::setupRapports()
+{
+    reportQueue = new ReportQueue(this);
+
+    // Rapport en cours dans la barre d'état, masqué quand la file est vide
+    panneauRapports = new QWidget(this);
+    QHBoxLayout *layout = new QHBoxLayout(panneauRapports);
+    layout->setContentsMargins(0, 0, 0, 0);
+    labelRapport = new QLabel(panneauRapports);
+    OliveraqTheme::apply(labelRapport, OliveraqTheme::Annotation);
+    progressRapport = new QProgressBar(panneauRapports);
+    progressRapport->setRange(0, 100);
+    progressRapport->setFixedWidth(160);
+    btnAnnulerRapport = new QPushButton("Annuler", panneauRapports);
+    OliveraqTheme::apply(btnAnnulerRapport, OliveraqTheme::BoutonSecondaire);
+    layout->addWidget(labelRapport);
+    layout->addWidget(progressRapport);
+    layout->addWidget(btnAnnulerRapport);
+    statusBar()->addPermanentWidget(panneauRapports);
+    panneauRapports->hide();
+
+    connect(reportQueue, &ReportQueue::changed, this, &MainWindow::afficherRapports);
+    connect(reportQueue, &ReportQueue::reportFinished, this, &MainWindow::rapportTermine);
+    connect(btnAnnulerRapport, &QPushButton::clicked, this, [this]() {
+        reportQueue->cancel(reportQueue->current());
+        labelRapport->setText("Annulation…");
+    });
+}
+
+void MainWindow::afficherRapports()
+{
+    const int id = reportQueue->current();
+    panneauRapports->setVisible(id != 0);
+    if (id == 0)
+        return;
+
+    QString texte = "PDF : " + reportQueue->title(id);
+    if (reportQueue->count() > 1)
+        texte += QString(" (+%1 en attente)").arg(reportQueue->count() - 1);
+    labelRapport->setText(texte);
+    progressRapport->setValue(reportQueue->progress(id));
+}
+
+void MainWindow::rapportTermine(const QString &path, ReportQueue::Outcome outcome, const QString &resume)
+{
+    switch (outcome) {
+    case ReportQueue::Generated:
+        if (resume.isEmpty())
+            statusBar()->showMessage("Fichier PDF généré : " + path, 5000);
+        else
+            QMessageBox::information(this, "Succès", resume + "\n" + path);
+        QDesktopServices::openUrl(QUrl::fromLocalFile(path));
+        break;
+    case ReportQueue::Cancelled:
+        statusBar()->showMessage("Génération du PDF annulée.", 5000);
+        break;
+    case ReportQueue::Failed:
+        QMessageBox::warning(this, "Erreur", "Impossible de générer le fichier PDF :\n" + path);
+        break;
+    }
+}
+
+void MainWindow::exporterFacturesLot(const QString &titre, const QString &libelle, const OrderStore &store,
+                                     const OrderTableModel *modele)
+{
+    // Période (mois en cours par défaut), statut et forme de la sortie
+    const QDate today = QDate::currentDate();
+    QDialog dialog(this);
+    dialog.setWindowTitle("Export groupé des factures");
+    QFormLayout *form = new QFormLayout(&dialog);
+
+    QDateEdit *editDebut = new QDateEdit(QDate(today.year(), today.month(), 1), &dialog);
+    QDateEdit *editFin = new QDateEdit(QDate(today.year(), today.month(), 1).addMonths(1).addDays(-1), &dialog);
+    for (QDateEdit *edit : {editDebut, editFin}) {
+        edit->setCalendarPopup(true);
+        edit->setDisplayFormat("dd/MM/yyyy");
+    }
+    QComboBox *comboStatut = new QComboBox(&dialog);
+    comboStatut->addItems({"Tous", "En cours", "Livrée"});
+    QRadioButton *radioParFacture = new QRadioButton("Un PDF par facture (dossier)", &dialog);
+    QRadioButton *radioFusion = new QRadioButton("Un seul PDF fusionné", &dialog);
+    radioParFacture->setChecked(true);
+    QDialogButtonBox *boutons = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+    connect(boutons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+    connect(boutons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+
+    form->addRow("Commandes du :", editDebut);
+    form->addRow("au :", editFin);
+    form->addRow("Statut :", comboStatut);
+    form->addRow(radioParFacture);
+    form->addRow(radioFusion);
+    form->addRow(boutons);
+
+    if (dialog.exec() != QDialog::Accepted)
+        return;
+
+    const QDate debut = editDebut->date();
+    const QDate fin = editFin->date();
+    const QString statut = comboStatut->currentIndex() == 0 ? QString() : comboStatut->currentText();
+
+    // Sélection dans l'ordre de la table : un simple parcours des
+    // identifiants, la mise en forme et le rendu se font hors du thread graphique
+    QVector<quint64> selection;
+    for (quint64 id : modele->ids()) {
+        const OrderRecord *record = store.find(id);
+        if (record && record->dateCommande >= debut && record->dateCommande <= fin
+            && (statut.isEmpty() || record->statut == statut))
+            selection.append(id);
+    }
+    if (selection.isEmpty()) {
+        QMessageBox::information(this, "Export groupé", "Aucune commande ne correspond à la période et au statut choisis.");
+        return;
+    }
+
+    LotFactures lot;
+    lot.fusion = radioFusion->isChecked();
+    if (lot.fusion) {
+        lot.destination = QFileDialog::getSaveFileName(this, "Enregistrer les factures",
+                                                       QString("Factures_%1_%2.pdf")
+                                                           .arg(libelle, debut.toString("yyyy_MM")),
+                                                       "PDF (*.pdf)");
+    } else {
+        lot.destination = QFileDialog::getExistingDirectory(this, "Dossier des factures");
+    }
+    if (lot.destination.isEmpty())
+        return;
+
+    lot.store = store;
+    lot.ids = std::move(selection);
+    lot.colonnes = modele->columns();
+    lot.titre = titre;
+    lot.libelle = libelle;
+    reportQueue->submitTask(QString("%1 factures").arg(lot.ids.size()), lot.destination, rapportFactures(lot));
+}
+
+// =======================
+// IMPLÉMENTATION - IMPORT EN MASSE
+// =======================
+
+void MainWindow::beginBulkLoad()
+{
+    if (bulkLoadDepth++ > 0)
+        return;
+
+    // Aucun rendu pendant le lot ; chaque modèle retient ses notifications
+    mainStack->setUpdatesEnabled(false);
+    modeleEmployes->beginBatch();
+    modeleFournisseurs->beginBatch();
+    modeleClients->beginBatch();
+    modeleProductions->beginBatch();
+    modelePerformanceFournisseurs->beginBatch();
+    modelePerformanceClients->beginBatch();
+}
+
+void MainWindow::endBulkLoad()
+{
+    if (bulkLoadDepth == 0 || --bulkLoadDepth > 0)
+        return;
+
+    modeleEmployes->endBatch();
+    modeleFournisseurs->endBatch();
+    modeleClients->endBatch();
+    modeleProductions->endBatch();
+    modelePerformanceFournisseurs->endBatch();
+    modelePerformanceClients->endBatch();
+
+    // Statistiques recalculées une seule fois pour tout le lot
+    rafraichirStatistiques();
+    if (pageVentes)
+        updateTableauVentes();
+    mainStack->setUpdatesEnabled(true);
+}
+
+void MainWindow::importerEmployes(const QVector<EmployeeRecord> &records)
+{
+    beginBulkLoad();
+    employeeStore.reserve(employeeStore.size() + records.size());
+    for (const EmployeeRecord &record : records) {
+        const quint64 id = employeeStore.insert(record);
+        ageBuckets.insert(id, record.dateNaissance);
+        modeleEmployes->recordInserted(id);
+    }
+    endBulkLoad();
+}
+
+void MainWindow::importerCommandesFournisseurs(const QVector<OrderRecord> &records)
+{
+    importerCommandes(fournisseurStore, livraisonsFournisseurs, modeleFournisseurs,
+                      &MainWindow::applyFournisseurDelta, records);
+}
+
+void MainWindow::importerCommandesClients(const QVector<OrderRecord> &records)
+{
+    importerCommandes(clientStore, livraisonsClients, modeleClients, &MainWindow::applyClientDelta, records);
+}
+
+void MainWindow::importerCommandes(OrderStore &store, DateSchedule &livraisons, OrderTableModel *modele,
+                                   void (MainWindow::*applyDelta)(const OrderRecord *, const OrderRecord *),
+                                   const QVector<OrderRecord> &records)
+{
+    beginBulkLoad();
+    store.reserve(store.size() + records.size());
+    for (OrderRecord record : records) {
+        record.id = store.insert(record);
+        (this->*applyDelta)(nullptr, &record);
+        modele->recordInserted(record.id);
+    }
+
+    // Les commandes importées dont la livraison est déjà échue passent à
+    // « Livrée » dans le même lot
+    livrerCommandesEchues(store, livraisons, modele, applyDelta, QDate::currentDate());
+    endBulkLoad();
+}
+
+void MainWindow::importerProductions(const QVector<ProductionRecord> &records)
+{
+    beginBulkLoad();
+    productionStore.reserve(productionStore.size() + records.size());
+    QSet<QString> types;
+    for (const ProductionRecord &record : records) {
+        modeleProductions->recordInserted(productionStore.insert(record));
+        types.insert(record.typeProduit);
+    }
+
+    if (pageStocks) {
+        for (const QString &type : std::as_const(types)) {
+            if (comboRechercheTypeStock->findText(type) == -1)
+                comboRechercheTypeStock->addItem(type);
+        }
+    }
+    endBulkLoad();
+
+    // Cube, séries et rendements reconstruits une seule fois, hors du thread
+    // graphique, plutôt qu'un delta par production
+    rebuildProductionAnalyticsAsync();
+}
+
 // =======================
 // IMPLÉMENTATION - NAVIGATION
 // =======================
 
+QWidget *MainWindow::ensurePage(Page page)
+{
+    // Une fabrique par page : le membre qui la référence et la fonction qui
+    // la construit (et l'ajoute à mainStack)
+    struct Factory
+    {
+        QWidget *MainWindow::*slot;
+        void (MainWindow::*build)();
+    };
+    static const Factory factories[] = {
+        {&MainWindow::pageChangePassword, &MainWindow::buildPageChangePassword},
+        {&MainWindow::pageEmployes, &MainWindow::buildPageEmployes},
+        {&MainWindow::pageFournisseurs, &MainWindow::buildPageFournisseurs},
+        {&MainWindow::pageClients, &MainWindow::buildPageClients},
+        {&MainWindow::pageStocks, &MainWindow::buildPageStocks},
+        {&MainWindow::pageVentes, &MainWindow::buildPageVentes},
+        {&MainWindow::pageQuiz, &MainWindow::buildPageQuiz},
+    };
+
+    const Factory &factory = factories[int(page)];
+    if (!(this->*factory.slot))
+        (this->*factory.build)();
+    return this->*factory.slot;
+}
+
+void MainWindow::prewarmNextPage()
+{
+    // Pré-chauffage après connexion : une page manquante par tour de boucle
+    // d'événements, pour ne jamais bloquer l'interface plus d'une construction
+    static const Page ordre[] = {Page::Employes, Page::Fournisseurs, Page::Clients,
+                                 Page::Stocks, Page::Ventes, Page::Quiz, Page::MotDePasse};
+
+    for (Page page : ordre) {
+        const int avant = mainStack->count();
+        ensurePage(page);
+        if (mainStack->count() != avant) {
+            QTimer::singleShot(0, this, &MainWindow::prewarmNextPage);
+            return;
+        }
+    }
+}
+
 void MainWindow::openGestionEmployes()
 {
-    mainStack->setCurrentWidget(pageEmployes);
+    mainStack->setCurrentWidget(ensurePage(Page::Employes));
     updateStatistics();
 }
 
 void MainWindow::openChangePassword()
 {
-    mainStack->setCurrentWidget(pageChangePassword);
+    mainStack->setCurrentWidget(ensurePage(Page::MotDePasse));
     editOldPass->clear();
     editNewPass->clear();
     editConfirmPass->clear();
@@ -2328,7 +5413,7 @@ void MainWindow::backToMenu()
 
 void MainWindow::openGestionFournisseurs()
 {
-    mainStack->setCurrentWidget(pageFournisseurs);
+    mainStack->setCurrentWidget(ensurePage(Page::Fournisseurs));
     stackedWidgetFournisseurs->setCurrentWidget(pageListeFournisseurs);
     updateFournisseurStatistics();
     updatePerformanceMetrics();
@@ -2336,7 +5421,7 @@ void MainWindow::openGestionFournisseurs()
 
 void MainWindow::openGestionClients()
 {
-    mainStack->setCurrentWidget(pageClients);
+    mainStack->setCurrentWidget(ensurePage(Page::Clients));
     stackedWidgetClients->setCurrentWidget(pageListeClients);
     updateClientStatistics();
     updateClientPerformance();
@@ -2344,13 +5429,19 @@ void MainWindow::openGestionClients()
 
 void MainWindow::openGestionStocks()
 {
-    mainStack->setCurrentWidget(pageStocks);
+    mainStack->setCurrentWidget(ensurePage(Page::Stocks));
     genererStatistiquesStock();
 }
 
+void MainWindow::openGestionVentes()
+{
+    mainStack->setCurrentWidget(ensurePage(Page::Ventes));
+    updateTableauVentes();
+}
+
 void MainWindow::openQuiz()
 {
-    mainStack->setCurrentWidget(pageQuiz);
+    mainStack->setCurrentWidget(ensurePage(Page::Quiz));
     handleQuizRestart();
 }
 
@@ -2410,7 +5501,7 @@ void MainWindow::showAjouter()
 
 void MainWindow::showModifier()
 {
-    int row = tableEmployes->currentRow();
+    int row = ligneCourante(tableEmployes);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner un employé à modifier.");
         return;
@@ -2419,15 +5510,15 @@ void MainWindow::showModifier()
     selectedRow = row;
     formTitle->setText("Modifier un employé");
 
-    editNom->setText(tableEmployes->item(row, 1)->text());
-    editPrenom->setText(tableEmployes->item(row, 2)->text());
-    editPoste->setText(tableEmployes->item(row, 3)->text());
-    editEmail->setText(tableEmployes->item(row, 4)->text());
-    editTelephone->setText(tableEmployes->item(row, 5)->text());
-    spinSalaire->setValue(tableEmployes->item(row, 6)->text().toInt());
-    spinHeures->setValue(tableEmployes->item(row, 7)->text().toInt());
-    dateEmbauche->setDate(QDate::fromString(tableEmployes->item(row, 8)->text(), "dd/MM/yyyy"));
-    dateNaissance->setDate(QDate::fromString(tableEmployes->item(row, 9)->text(), "dd/MM/yyyy"));
+    editNom->setText(modeleEmployes->text(row, 1));
+    editPrenom->setText(modeleEmployes->text(row, 2));
+    editPoste->setText(modeleEmployes->text(row, 3));
+    editEmail->setText(modeleEmployes->text(row, 4));
+    editTelephone->setText(modeleEmployes->text(row, 5));
+    spinSalaire->setValue(modeleEmployes->text(row, 6).toInt());
+    spinHeures->setValue(modeleEmployes->text(row, 7).toInt());
+    dateEmbauche->setDate(QDate::fromString(modeleEmployes->text(row, 8), "dd/MM/yyyy"));
+    dateNaissance->setDate(QDate::fromString(modeleEmployes->text(row, 9), "dd/MM/yyyy"));
 }
 
 void MainWindow::enregistrer()
@@ -2439,54 +5530,47 @@ void MainWindow::enregistrer()
     QString email = editEmail->text().trimmed();
     int salaire = spinSalaire->value();
     int heures = spinHeures->value();
-    QString dateEmb = dateEmbauche->date().toString("dd/MM/yyyy");
-    QString dateNais = dateNaissance->date().toString("dd/MM/yyyy");
 
     if (nom.isEmpty() || prenom.isEmpty()) {
         QMessageBox::warning(this, "Erreur", "Veuillez remplir au moins le nom et le prénom.");
         return;
     }
 
+    EmployeeRecord record;
+    record.nom = nom;
+    record.prenom = prenom;
+    record.poste = poste;
+    record.email = email;
+    record.telephone = tel;
+    record.salaire = salaire;
+    record.heures = heures;
+    record.dateEmbauche = dateEmbauche->date();
+    record.dateNaissance = dateNaissance->date();
+
     if (selectedRow == -1) {
         // Ajout
-        int row = tableEmployes->rowCount();
-        tableEmployes->insertRow(row);
-
-        tableEmployes->setItem(row, 0, new QTableWidgetItem(QString::number(row + 1)));
-        tableEmployes->setItem(row, 1, new QTableWidgetItem(nom));
-        tableEmployes->setItem(row, 2, new QTableWidgetItem(prenom));
-        tableEmployes->setItem(row, 3, new QTableWidgetItem(poste));
-        tableEmployes->setItem(row, 4, new QTableWidgetItem(email));
-        tableEmployes->setItem(row, 5, new QTableWidgetItem(tel));
-        tableEmployes->setItem(row, 6, new QTableWidgetItem(QString::number(salaire)));
-        tableEmployes->setItem(row, 7, new QTableWidgetItem(QString::number(heures)));
-        tableEmployes->setItem(row, 8, new QTableWidgetItem(dateEmb));
-        tableEmployes->setItem(row, 9, new QTableWidgetItem(dateNais));
+        quint64 id = employeeStore.insert(record);
+        ageBuckets.insert(id, record.dateNaissance);
+        modeleEmployes->recordInserted(id);
 
         QMessageBox::information(this, "Succès", "Employé ajouté avec succès !");
     } else {
         // Modification
-        tableEmployes->item(selectedRow, 1)->setText(nom);
-        tableEmployes->item(selectedRow, 2)->setText(prenom);
-        tableEmployes->item(selectedRow, 3)->setText(poste);
-        tableEmployes->item(selectedRow, 4)->setText(email);
-        tableEmployes->item(selectedRow, 5)->setText(tel);
-        tableEmployes->item(selectedRow, 6)->setText(QString::number(salaire));
-        tableEmployes->item(selectedRow, 7)->setText(QString::number(heures));
-        tableEmployes->item(selectedRow, 8)->setText(dateEmb);
-        tableEmployes->item(selectedRow, 9)->setText(dateNais);
+        record.id = modeleEmployes->idAt(selectedRow);
+        employeeStore.update(record);
+        ageBuckets.insert(record.id, record.dateNaissance);
+        modeleEmployes->recordUpdated(record.id);
 
         QMessageBox::information(this, "Succès", "Employé modifié avec succès !");
     }
 
-    reindexIds();
     updateStatistics();
     showAjouter();
 }
 
 void MainWindow::supprimer()
 {
-    int row = tableEmployes->currentRow();
+    int row = ligneCourante(tableEmployes);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner un employé à supprimer.");
         return;
@@ -2497,8 +5581,10 @@ void MainWindow::supprimer()
         QMessageBox::Yes | QMessageBox::No);
 
     if (reply == QMessageBox::Yes) {
-        tableEmployes->removeRow(row);
-        reindexIds();
+        quint64 id = modeleEmployes->idAt(row);
+        employeeStore.remove(id);
+        ageBuckets.remove(id);
+        modeleEmployes->recordRemoved(id);
         updateStatistics();
         QMessageBox::information(this, "Succès", "Employé supprimé avec succès !");
     }
@@ -2511,14 +5597,17 @@ void MainWindow::tableSelectionChanged()
 
 void MainWindow::searchByName()
 {
-    QString query = editSearch->text().trimmed().toLower();
-
-    for (int i = 0; i < tableEmployes->rowCount(); ++i) {
-        QString nom = tableEmployes->item(i, 1)->text().toLower();
-        QString prenom = tableEmployes->item(i, 2)->text().toLower();
-        bool match = nom.contains(query) || prenom.contains(query);
-        tableEmployes->setRowHidden(i, !match);
+    const QString query = editSearch->text().trimmed();
+    if (query.isEmpty()) {
+        filtreEmployes->setFilter({});
+        return;
     }
+
+    filtreEmployes->setFilter([this, query](int row) {
+        const EmployeeRecord *record = employeeStore.find(modeleEmployes->idAt(row));
+        return record && (record->nom.contains(query, Qt::CaseInsensitive)
+                          || record->prenom.contains(query, Qt::CaseInsensitive));
+    });
 }
 
 void MainWindow::sortBySalary()
@@ -2527,25 +5616,29 @@ void MainWindow::sortBySalary()
 
     if (index == 0) {
         // Croissant
-        tableEmployes->sortItems(6, Qt::AscendingOrder);
+        modeleEmployes->sortRecords([](const EmployeeRecord &a, const EmployeeRecord &b) {
+            return a.salaire < b.salaire;
+        });
     } else if (index == 1) {
         // Décroissant
-        tableEmployes->sortItems(6, Qt::DescendingOrder);
+        modeleEmployes->sortRecords([](const EmployeeRecord &a, const EmployeeRecord &b) {
+            return a.salaire > b.salaire;
+        });
     }
 }
 
 void MainWindow::extractAttestation()
 {
-    int row = tableEmployes->currentRow();
+    int row = ligneCourante(tableEmployes);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner un employé.");
         return;
     }
 
-    QString nom = tableEmployes->item(row, 1)->text();
-    QString prenom = tableEmployes->item(row, 2)->text();
-    QString poste = tableEmployes->item(row, 3)->text();
-    QString dateEmb = tableEmployes->item(row, 8)->text();
+    QString nom = modeleEmployes->text(row, 1);
+    QString prenom = modeleEmployes->text(row, 2);
+    QString poste = modeleEmployes->text(row, 3);
+    QString dateEmb = modeleEmployes->text(row, 8);
 
     QString fileName = QFileDialog::getSaveFileName(this, "Enregistrer attestation",
                                                     "Attestation_" + nom + "_" + prenom + ".pdf",
@@ -2553,11 +5646,6 @@ void MainWindow::extractAttestation()
 
     if (fileName.isEmpty()) return;
 
-    QPrinter printer(QPrinter::HighResolution);
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setOutputFileName(fileName);
-    printer.setPageSize(QPageSize(QPageSize::A4));
-
     QString html = "<html><head><style>"
                    "body { font-family: Arial; margin: 60px; }"
                    "h1 { color: #556b2f; text-align: center; margin-bottom: 40px; }"
@@ -2576,66 +5664,32 @@ void MainWindow::extractAttestation()
     html += "</div>";
     html += "</body></html>";
 
-    QTextDocument doc;
-    doc.setHtml(html);
-    doc.print(&printer);
-
-    QMessageBox::information(this, "Succès", "Attestation générée avec succès !");
-    QDesktopServices::openUrl(QUrl::fromLocalFile(fileName));
-}
-
-void MainWindow::reindexIds()
-{
-    for (int i = 0; i < tableEmployes->rowCount(); ++i) {
-        tableEmployes->item(i, 0)->setText(QString::number(i + 1));
-    }
+    // Le HTML ne contient que des copies : le rendu ne touche pas au modèle
+    reportQueue->submit("Attestation " + prenom + " " + nom, fileName, rapportHtml(html));
 }
 
 void MainWindow::updateStatistics()
 {
-    int total = tableEmployes->rowCount();
-    if (total == 0) {
-        chartWidget->setData(QMap<QString, int>(), 0);
-        return;
-    }
-
-    int jeunes = 0;      // < 30 ans
-    int adultes = 0;     // 30-50 ans
-    int seniors = 0;     // > 50 ans
-
-    QDate today = QDate::currentDate();
-
-    for (int i = 0; i < total; ++i) {
-        QString dateNaisStr = tableEmployes->item(i, 9)->text();
-        QDate dateNais = QDate::fromString(dateNaisStr, "dd/MM/yyyy");
-        int age = dateNais.daysTo(today) / 365;
+    // Seuls les employés ayant changé de tranche depuis le dernier appel sont déplacés
+    ageBuckets.advanceTo(QDate::currentDate());
 
-        if (age < 30) {
-            jeunes++;
-        } else if (age <= 50) {
-            adultes++;
-        } else {
-            seniors++;
-        }
-    }
+    int jeunes = ageBuckets.count(AgeBucketIndex::Jeunes);      // < 30 ans
+    int adultes = ageBuckets.count(AgeBucketIndex::Adultes);    // 30-50 ans
+    int seniors = ageBuckets.count(AgeBucketIndex::Seniors);    // > 50 ans
 
     QMap<QString, int> data;
-    int totalCount = 0;
 
     if (jeunes > 0) {
         data["< 30 ans"] = jeunes;
-        totalCount += jeunes;
     }
     if (adultes > 0) {
         data["30-50 ans"] = adultes;
-        totalCount += adultes;
     }
     if (seniors > 0) {
         data["> 50 ans"] = seniors;
-        totalCount += seniors;
     }
 
-    chartWidget->setData(data, totalCount);
+    chartWidget->setData(std::move(data), ageBuckets.total());
 }
 
 // =======================
@@ -2678,8 +5732,6 @@ void MainWindow::on_btnEnregistrer_clicked()
     QString email = editEmailFournisseur->text().trimmed();
     QString tel = editTelephoneFournisseur->text().trimmed();
     QString produit = editProduitFournisseur->text().trimmed();
-    QString dateCmd = editDateCommande->date().toString("dd/MM/yyyy");
-    QString dateLiv = editDateLivraison->date().toString("dd/MM/yyyy");
     QString prixHT = editPrixHT->text().trimmed();
     QString modePaie = comboModePaiement->currentText();
     QString tva = editTVA->text().trimmed();
@@ -2697,39 +5749,37 @@ void MainWindow::on_btnEnregistrer_clicked()
     QDate livDate = editDateLivraison->date();
     QString statut = (livDate <= today) ? "Livrée" : "En cours";
 
+    OrderRecord record;
+    record.nom = nom;
+    record.email = email;
+    record.telephone = tel;
+    record.produit = produit;
+    record.dateCommande = editDateCommande->date();
+    record.dateLivraison = livDate;
+    record.prixHT = prixHT.toDouble();
+    record.modePaiement = modePaie;
+    record.statut = statut;
+    record.prixTTC = prixTTC.toDouble();
+    record.avance = avance.toDouble();
+    record.resteAPayer = reste.isEmpty() ? record.prixTTC - record.avance : reste.toDouble();
+
     if (currentRowFournisseur == -1) {
         // Ajout
-        int row = tableFournisseurs->rowCount();
-        tableFournisseurs->insertRow(row);
-
-        QString idCmd = "CMD-F-" + QString::number(row + 1);
-
-        tableFournisseurs->setItem(row, 0, new QTableWidgetItem(idCmd));
-        tableFournisseurs->setItem(row, 1, new QTableWidgetItem(nom));
-        tableFournisseurs->setItem(row, 2, new QTableWidgetItem(email));
-        tableFournisseurs->setItem(row, 3, new QTableWidgetItem(tel));
-        tableFournisseurs->setItem(row, 4, new QTableWidgetItem(produit));
-        tableFournisseurs->setItem(row, 5, new QTableWidgetItem(dateCmd));
-        tableFournisseurs->setItem(row, 6, new QTableWidgetItem(dateLiv));
-        tableFournisseurs->setItem(row, 7, new QTableWidgetItem(prixHT));
-        tableFournisseurs->setItem(row, 8, new QTableWidgetItem(modePaie));
-        tableFournisseurs->setItem(row, 9, new QTableWidgetItem(statut));
-        tableFournisseurs->setItem(row, 10, new QTableWidgetItem("1")); // Quantité par défaut
-        tableFournisseurs->setItem(row, 11, new QTableWidgetItem(prixTTC));
+        record.id = fournisseurStore.insert(record);
+        applyFournisseurDelta(nullptr, &record);
+        modeleFournisseurs->recordInserted(record.id);
 
         QMessageBox::information(this, "Succès", "Fournisseur ajouté avec succès !");
     } else {
         // Modification
-        tableFournisseurs->item(currentRowFournisseur, 1)->setText(nom);
-        tableFournisseurs->item(currentRowFournisseur, 2)->setText(email);
-        tableFournisseurs->item(currentRowFournisseur, 3)->setText(tel);
-        tableFournisseurs->item(currentRowFournisseur, 4)->setText(produit);
-        tableFournisseurs->item(currentRowFournisseur, 5)->setText(dateCmd);
-        tableFournisseurs->item(currentRowFournisseur, 6)->setText(dateLiv);
-        tableFournisseurs->item(currentRowFournisseur, 7)->setText(prixHT);
-        tableFournisseurs->item(currentRowFournisseur, 8)->setText(modePaie);
-        tableFournisseurs->item(currentRowFournisseur, 9)->setText(statut);
-        tableFournisseurs->item(currentRowFournisseur, 11)->setText(prixTTC);
+        record.id = modeleFournisseurs->idAt(currentRowFournisseur);
+        if (const OrderRecord *found = fournisseurStore.find(record.id)) {
+            OrderRecord previous = *found;
+            record.quantite = previous.quantite;
+            fournisseurStore.update(record);
+            applyFournisseurDelta(&previous, &record);
+            modeleFournisseurs->recordUpdated(record.id);
+        }
 
         QMessageBox::information(this, "Succès", "Fournisseur modifié avec succès !");
     }
@@ -2741,7 +5791,7 @@ void MainWindow::on_btnEnregistrer_clicked()
 
 void MainWindow::on_btnModifier_clicked()
 {
-    int row = tableFournisseurs->currentRow();
+    int row = ligneCourante(tableFournisseurs);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner un fournisseur à modifier.");
         return;
@@ -2750,20 +5800,24 @@ void MainWindow::on_btnModifier_clicked()
     currentRowFournisseur = row;
     stackedWidgetFournisseurs->setCurrentWidget(pageFormulaireFournisseurs);
 
-    editIDCommande->setText(tableFournisseurs->item(row, 0)->text());
-    editNomFournisseur->setText(tableFournisseurs->item(row, 1)->text());
-    editEmailFournisseur->setText(tableFournisseurs->item(row, 2)->text());
-    editTelephoneFournisseur->setText(tableFournisseurs->item(row, 3)->text());
-    editProduitFournisseur->setText(tableFournisseurs->item(row, 4)->text());
-    editDateCommande->setDate(QDate::fromString(tableFournisseurs->item(row, 5)->text(), "dd/MM/yyyy"));
-    editDateLivraison->setDate(QDate::fromString(tableFournisseurs->item(row, 6)->text(), "dd/MM/yyyy"));
-    editPrixHT->setText(tableFournisseurs->item(row, 7)->text());
-    comboModePaiement->setCurrentText(tableFournisseurs->item(row, 8)->text());
+    editIDCommande->setText(modeleFournisseurs->text(row, 0));
+    editNomFournisseur->setText(modeleFournisseurs->text(row, 1));
+    editEmailFournisseur->setText(modeleFournisseurs->text(row, 2));
+    editTelephoneFournisseur->setText(modeleFournisseurs->text(row, 3));
+    editProduitFournisseur->setText(modeleFournisseurs->text(row, 4));
+    editDateCommande->setDate(QDate::fromString(modeleFournisseurs->text(row, 5), "dd/MM/yyyy"));
+    editDateLivraison->setDate(QDate::fromString(modeleFournisseurs->text(row, 6), "dd/MM/yyyy"));
+    editPrixHT->setText(modeleFournisseurs->text(row, 7));
+    comboModePaiement->setCurrentText(modeleFournisseurs->text(row, 8));
+
+    if (const OrderRecord *record = fournisseurStore.find(modeleFournisseurs->idAt(row))) {
+        editAvance->setText(QString::number(record->avance, 'f', 2));
+    }
 }
 
 void MainWindow::on_btnSupprimer_clicked()
 {
-    int row = tableFournisseurs->currentRow();
+    int row = ligneCourante(tableFournisseurs);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner un fournisseur à supprimer.");
         return;
@@ -2774,7 +5828,13 @@ void MainWindow::on_btnSupprimer_clicked()
         QMessageBox::Yes | QMessageBox::No);
 
     if (reply == QMessageBox::Yes) {
-        tableFournisseurs->removeRow(row);
+        quint64 id = modeleFournisseurs->idAt(row);
+        if (const OrderRecord *found = fournisseurStore.find(id)) {
+            OrderRecord previous = *found;
+            fournisseurStore.remove(id);
+            applyFournisseurDelta(&previous, nullptr);
+        }
+        modeleFournisseurs->recordRemoved(id);
         QMessageBox::information(this, "Succès", "Fournisseur supprimé avec succès !");
         updateFournisseurStatistics();
         updatePerformanceMetrics();
@@ -2783,7 +5843,7 @@ void MainWindow::on_btnSupprimer_clicked()
 
 void MainWindow::on_btnDetails_clicked()
 {
-    int row = tableFournisseurs->currentRow();
+    int row = ligneCourante(tableFournisseurs);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner un fournisseur pour voir les détails.");
         return;
@@ -2791,23 +5851,25 @@ void MainWindow::on_btnDetails_clicked()
 
     stackedWidgetFournisseurs->setCurrentWidget(pageDetailsFournisseurs);
 
-    detailIdCommande->setText(tableFournisseurs->item(row, 0)->text());
-    detailNom->setText(tableFournisseurs->item(row, 1)->text());
-    detailEmail->setText(tableFournisseurs->item(row, 2)->text());
-    detailTelephone->setText(tableFournisseurs->item(row, 3)->text());
-    detailProduit->setText(tableFournisseurs->item(row, 4)->text());
-    detailDateCommande->setText(tableFournisseurs->item(row, 5)->text());
-    detailDateLivraison->setText(tableFournisseurs->item(row, 6)->text());
-    detailPrixHT->setText(tableFournisseurs->item(row, 7)->text() + " DT");
-    detailModePaiement->setText(tableFournisseurs->item(row, 8)->text());
-    detailStatut->setText(tableFournisseurs->item(row, 9)->text());
-    detailQte->setText(tableFournisseurs->item(row, 10)->text());
-    detailPrixTTC->setText(tableFournisseurs->item(row, 11)->text() + " DT");
+    detailIdCommande->setText(modeleFournisseurs->text(row, 0));
+    detailNom->setText(modeleFournisseurs->text(row, 1));
+    detailEmail->setText(modeleFournisseurs->text(row, 2));
+    detailTelephone->setText(modeleFournisseurs->text(row, 3));
+    detailProduit->setText(modeleFournisseurs->text(row, 4));
+    detailDateCommande->setText(modeleFournisseurs->text(row, 5));
+    detailDateLivraison->setText(modeleFournisseurs->text(row, 6));
+    detailPrixHT->setText(modeleFournisseurs->text(row, 7) + " DT");
+    detailModePaiement->setText(modeleFournisseurs->text(row, 8));
+    detailStatut->setText(modeleFournisseurs->text(row, 9));
+    detailQte->setText(modeleFournisseurs->text(row, 10));
+    detailPrixTTC->setText(modeleFournisseurs->text(row, 11) + " DT");
 
     detailTVA->setText("19%");
     detailRemise->setText("0%");
-    detailAvance->setText("0 DT");
-    detailResteAPayer->setText(tableFournisseurs->item(row, 11)->text() + " DT");
+    if (const OrderRecord *record = fournisseurStore.find(modeleFournisseurs->idAt(row))) {
+        detailAvance->setText(QString::number(record->avance, 'f', 2) + " DT");
+        detailResteAPayer->setText(QString::number(record->resteAPayer, 'f', 2) + " DT");
+    }
 }
 
 void MainWindow::on_btnRetourDetail_clicked()
@@ -2817,13 +5879,16 @@ void MainWindow::on_btnRetourDetail_clicked()
 
 void MainWindow::searchFournisseur()
 {
-    QString query = searchFournisseurEdit->text().trimmed().toLower();
-
-    for (int i = 0; i < tableFournisseurs->rowCount(); ++i) {
-        QString nom = tableFournisseurs->item(i, 1)->text().toLower();
-        bool match = nom.contains(query);
-        tableFournisseurs->setRowHidden(i, !match);
+    const QString query = searchFournisseurEdit->text().trimmed();
+    if (query.isEmpty()) {
+        filtreFournisseurs->setFilter({});
+        return;
     }
+
+    filtreFournisseurs->setFilter([this, query](int row) {
+        const OrderRecord *record = fournisseurStore.find(modeleFournisseurs->idAt(row));
+        return record && record->nom.contains(query, Qt::CaseInsensitive);
+    });
 }
 
 void MainWindow::sortCommandesParNom()
@@ -2832,155 +5897,146 @@ void MainWindow::sortCommandesParNom()
 
     if (index == 0) {
         // Trier par nom A-Z
-        tableFournisseurs->sortItems(1, Qt::AscendingOrder);
+        modeleFournisseurs->sortRecords([](const OrderRecord &a, const OrderRecord &b) {
+            return a.nom < b.nom;
+        });
     } else if (index == 1) {
         // Trier par nom Z-A
-        tableFournisseurs->sortItems(1, Qt::DescendingOrder);
+        modeleFournisseurs->sortRecords([](const OrderRecord &a, const OrderRecord &b) {
+            return a.nom > b.nom;
+        });
     } else if (index == 2) {
         // Trier par date commande
-        tableFournisseurs->sortItems(5, Qt::DescendingOrder);
+        modeleFournisseurs->sortRecords([](const OrderRecord &a, const OrderRecord &b) {
+            return a.dateCommande > b.dateCommande;
+        });
     }
 }
 
 void MainWindow::exportFacturePDF()
 {
-    int row = tableFournisseurs->currentRow();
+    int row = ligneCourante(tableFournisseurs);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner une commande fournisseur.");
         return;
     }
 
     QString fileName = QFileDialog::getSaveFileName(this, "Enregistrer facture",
-                                                    "Facture_Fournisseur_" + tableFournisseurs->item(row, 1)->text() + ".pdf",
+                                                    "Facture_Fournisseur_" + modeleFournisseurs->text(row, 1) + ".pdf",
                                                     "PDF (*.pdf)");
 
-    if (fileName.isEmpty()) return;
-
-    QPrinter printer(QPrinter::HighResolution);
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setOutputFileName(fileName);
-    printer.setPageSize(QPageSize(QPageSize::A4));
-
-    QString html = "<html><head><style>"
-                   "body { font-family: Arial; margin: 40px; }"
-                   "h1 { color: #556b2f; text-align: center; }"
-                   "table { width: 100%; border-collapse: collapse; margin-top: 20px; }"
-                   "td, th { border: 1px solid #ddd; padding: 12px; text-align: left; }"
-                   "th { background-color: #f0f0f0; font-weight: bold; }"
-                   ".total { font-size: 18px; font-weight: bold; color: #556b2f; }"
-                   "</style></head><body>";
-
-    html += "<h1>FACTURE FOURNISSEUR</h1>";
-    html += "<p><b>Date:</b> " + QDate::currentDate().toString("dd/MM/yyyy") + "</p>";
-    html += "<p><b>ID Commande:</b> " + tableFournisseurs->item(row, 0)->text() + "</p>";
-
-    html += "<table>";
-    html += "<tr><th>Fournisseur</th><td>" + tableFournisseurs->item(row, 1)->text() + "</td></tr>";
-    html += "<tr><th>Email</th><td>" + tableFournisseurs->item(row, 2)->text() + "</td></tr>";
-    html += "<tr><th>Téléphone</th><td>" + tableFournisseurs->item(row, 3)->text() + "</td></tr>";
-    html += "<tr><th>Produit</th><td>" + tableFournisseurs->item(row, 4)->text() + "</td></tr>";
-    html += "<tr><th>Date commande</th><td>" + tableFournisseurs->item(row, 5)->text() + "</td></tr>";
-    html += "<tr><th>Date livraison</th><td>" + tableFournisseurs->item(row, 6)->text() + "</td></tr>";
-    html += "<tr><th>Prix HT</th><td>" + tableFournisseurs->item(row, 7)->text() + " DT</td></tr>";
-    html += "<tr><th>TVA</th><td>19%</td></tr>";
-    html += "<tr><th class='total'>Prix TTC</th><td class='total'>" + tableFournisseurs->item(row, 11)->text() + " DT</td></tr>";
-    html += "<tr><th>Mode de paiement</th><td>" + tableFournisseurs->item(row, 8)->text() + "</td></tr>";
-    html += "<tr><th>Statut</th><td>" + tableFournisseurs->item(row, 9)->text() + "</td></tr>";
-    html += "</table>";
-
-    html += "</body></html>";
+    if (fileName.isEmpty()) return;
 
-    QTextDocument doc;
-    doc.setHtml(html);
-    doc.print(&printer);
+    QStringList cellules;
+    for (int column = 0; column < modeleFournisseurs->columnCount(); ++column)
+        cellules.append(modeleFournisseurs->text(row, column));
 
-    QMessageBox::information(this, "Succès", "Facture exportée avec succès !");
-    QDesktopServices::openUrl(QUrl::fromLocalFile(fileName));
+    reportQueue->submit("Facture " + cellules.value(0), fileName,
+                        rapportHtml(factureHtml("FACTURE FOURNISSEUR", "Fournisseur", cellules)));
 }
 
-void MainWindow::updateFournisseurStatistics()
+void MainWindow::exportFacturesLotFournisseurs()
 {
-    int totalFournisseurs = tableFournisseurs->rowCount();
-    int totalCommandes = totalFournisseurs;
-    int enCours = 0;
-    int livrees = 0;
-
-    for (int i = 0; i < tableFournisseurs->rowCount(); ++i) {
-        QString statut = tableFournisseurs->item(i, 9)->text();
-        if (statut == "En cours") {
-            enCours++;
-        } else if (statut == "Livrée") {
-            livrees++;
-        }
-    }
+    exporterFacturesLot("FACTURE FOURNISSEUR", "Fournisseur", fournisseurStore, modeleFournisseurs);
+}
 
-    double tauxLivraison = (totalCommandes > 0) ? (livrees * 100.0 / totalCommandes) : 0.0;
+void MainWindow::updateFournisseurStatistics()
+{
+    // Compteurs maintenus par delta : aucun parcours de la table
+    const OrderCounters &counters = fournisseurCounters;
 
-    labelTotalFournisseurs->setText("Total fournisseurs: " + QString::number(totalFournisseurs));
-    labelTotalCommandes->setText("Total commandes: " + QString::number(totalCommandes));
-    labelCommandesEnCours->setText("En cours: " + QString::number(enCours));
-    labelCommandesLivrees->setText("Livrées: " + QString::number(livrees));
-    labelTauxLivraison->setText("Taux livraison: " + QString::number(tauxLivraison, 'f', 1) + "%");
+    labelTotalFournisseurs->setText("Total fournisseurs: " + QString::number(counters.total));
+    labelTotalCommandes->setText("Total commandes: " + QString::number(counters.total));
+    labelCommandesEnCours->setText("En cours: " + QString::number(counters.enCours));
+    labelCommandesLivrees->setText("Livrées: " + QString::number(counters.livrees));
+    labelTauxLivraison->setText("Taux livraison: " + QString::number(counters.tauxLivraison(), 'f', 1) + "%");
 
     QMap<QString, int> data;
     int totalCount = 0;
 
-    if (enCours > 0) {
-        data["En cours"] = enCours;
-        totalCount += enCours;
+    if (counters.enCours > 0) {
+        data["En cours"] = counters.enCours;
+        totalCount += counters.enCours;
     }
-    if (livrees > 0) {
-        data["Livrées"] = livrees;
-        totalCount += livrees;
+    if (counters.livrees > 0) {
+        data["Livrées"] = counters.livrees;
+        totalCount += counters.livrees;
     }
 
     if (!data.isEmpty()) {
-        chartFournisseurs->setData(data, totalCount);
+        chartFournisseurs->setData(std::move(data), totalCount);
     }
 }
 
 void MainWindow::updatePerformanceMetrics()
 {
-    tablePerformance->setRowCount(0);
-
-    QMap<QString, int> commandesTotales;
-    QMap<QString, int> commandesLivrees;
+    // Le tableau de performance est mis à jour ligne par ligne dans
+    // applyFournisseurDelta() ; le meilleur fournisseur est au sommet du tas.
+    QString meilleur = "-";
+    int maxCommandes = 0;
+    if (!fournisseurPerformance.isEmpty()) {
+        meilleur = fournisseurPerformance.meilleur();
+        maxCommandes = fournisseurPerformance.meilleurTotal();
+    }
 
-    for (int i = 0; i < tableFournisseurs->rowCount(); ++i) {
-        QString nom = tableFournisseurs->item(i, 1)->text();
-        QString statut = tableFournisseurs->item(i, 9)->text();
+    labelMeilleurFournisseur->setText("🏆 Meilleur fournisseur: " + meilleur + " (" + QString::number(maxCommandes) + " commandes)");
 
-        commandesTotales[nom]++;
-        if (statut == "Livrée") {
-            commandesLivrees[nom]++;
-        }
+    // Le plus rapide est la tête du classement des délais médians
+    QString rapide = "-";
+    const QVector<LeadTimeIndex::RankedEntry> premiers = fournisseurDelais.ranking(1);
+    if (!premiers.isEmpty()) {
+        rapide = QString("%1 (médiane %2 j, p90 %3 j)")
+                     .arg(premiers.first().nom)
+                     .arg(premiers.first().summary.p50)
+                     .arg(premiers.first().summary.p90);
     }
+    labelFournisseurRapide->setText("⚡ Fournisseur le plus rapide: " + rapide);
 
-    for (auto it = commandesTotales.begin(); it != commandesTotales.end(); ++it) {
-        QString nom = it.key();
-        int total = it.value();
-        int livrees = commandesLivrees.value(nom, 0);
-        double taux = (total > 0) ? (livrees * 100.0 / total) : 0.0;
+    updateClassementDelais();
+    updateEncours(tableEncoursFournisseurs, fournisseurEncours);
+}
 
-        int row = tablePerformance->rowCount();
-        tablePerformance->insertRow(row);
-        tablePerformance->setItem(row, 0, new QTableWidgetItem(nom));
-        tablePerformance->setItem(row, 1, new QTableWidgetItem(QString::number(total)));
-        tablePerformance->setItem(row, 2, new QTableWidgetItem(QString::number(livrees)));
-        tablePerformance->setItem(row, 3, new QTableWidgetItem(QString::number(taux, 'f', 1) + "%"));
+void MainWindow::updateClassementDelais()
+{
+    const QVector<LeadTimeIndex::RankedEntry> classement = fournisseurDelais.ranking(10);
+
+    tableClassementDelais->setRowCount(classement.size());
+    for (int row = 0; row < classement.size(); ++row) {
+        const LeadTimeIndex::RankedEntry &entry = classement[row];
+        tableClassementDelais->setItem(row, 0, new QTableWidgetItem(entry.nom));
+        tableClassementDelais->setItem(row, 1, new QTableWidgetItem(QString::number(entry.summary.commandes)));
+        tableClassementDelais->setItem(row, 2, new QTableWidgetItem(QString::number(entry.summary.p50)));
+        tableClassementDelais->setItem(row, 3, new QTableWidgetItem(QString::number(entry.summary.p90)));
     }
+}
 
-    QString meilleur = "-";
-    int maxCommandes = 0;
-    for (auto it = commandesTotales.begin(); it != commandesTotales.end(); ++it) {
-        if (it.value() > maxCommandes) {
-            maxCommandes = it.value();
-            meilleur = it.key();
-        }
+void MainWindow::applyFournisseurDelta(const OrderRecord *before, const OrderRecord *after)
+{
+    if (before) {
+        fournisseurCounters.remove(*before);
+        fournisseurPerformance.remove(*before);
+        fournisseurDelais.remove(*before);
+        fournisseurEncours.remove(before->id);
+        ventes.removeAchat(*before);
+        if (before->statut == "En cours")
+            livraisonsFournisseurs.cancel(before->dateLivraison, before->id);
+    }
+    if (after) {
+        fournisseurCounters.add(*after);
+        fournisseurPerformance.add(*after);
+        fournisseurDelais.add(*after);
+        fournisseurEncours.insert(*after);
+        ventes.addAchat(*after);
+        if (after->statut == "En cours")
+            livraisonsFournisseurs.schedule(after->dateLivraison, after->id);
     }
 
-    labelMeilleurFournisseur->setText("🏆 Meilleur fournisseur: " + meilleur + " (" + QString::number(maxCommandes) + " commandes)");
-    labelFournisseurRapide->setText("⚡ Fournisseur le plus rapide: " + meilleur);
+    if (before) {
+        modelePerformanceFournisseurs->partnerChanged(before->nom);
+    }
+    if (after && (!before || after->nom != before->nom)) {
+        modelePerformanceFournisseurs->partnerChanged(after->nom);
+    }
 }
 
 void MainWindow::calculatePrixTTC()
@@ -3045,8 +6101,6 @@ void MainWindow::on_btnEnregistrerClient_clicked()
     QString email = editEmailClient->text().trimmed();
     QString tel = editTelephoneClient->text().trimmed();
     QString produit = editProduitClient->text().trimmed();
-    QString dateCmd = editDateCommandeClient->date().toString("dd/MM/yyyy");
-    QString dateLiv = editDateLivraisonClient->date().toString("dd/MM/yyyy");
     QString prixHT = editPrixHTClient->text().trimmed();
     QString modePaie = comboModePaiementClient->currentText();
     QString tva = editTVAClient->text().trimmed();
@@ -3064,39 +6118,37 @@ void MainWindow::on_btnEnregistrerClient_clicked()
     QDate livDate = editDateLivraisonClient->date();
     QString statut = (livDate <= today) ? "Livrée" : "En cours";
 
+    OrderRecord record;
+    record.nom = nom;
+    record.email = email;
+    record.telephone = tel;
+    record.produit = produit;
+    record.dateCommande = editDateCommandeClient->date();
+    record.dateLivraison = livDate;
+    record.prixHT = prixHT.toDouble();
+    record.modePaiement = modePaie;
+    record.statut = statut;
+    record.prixTTC = prixTTC.toDouble();
+    record.avance = avance.toDouble();
+    record.resteAPayer = reste.isEmpty() ? record.prixTTC - record.avance : reste.toDouble();
+
     if (currentRowClient == -1) {
         // Ajout
-        int row = tableClients->rowCount();
-        tableClients->insertRow(row);
-
-        QString idCmd = "CMD-C-" + QString::number(row + 1);
-
-        tableClients->setItem(row, 0, new QTableWidgetItem(idCmd));
-        tableClients->setItem(row, 1, new QTableWidgetItem(nom));
-        tableClients->setItem(row, 2, new QTableWidgetItem(email));
-        tableClients->setItem(row, 3, new QTableWidgetItem(tel));
-        tableClients->setItem(row, 4, new QTableWidgetItem(produit));
-        tableClients->setItem(row, 5, new QTableWidgetItem(dateCmd));
-        tableClients->setItem(row, 6, new QTableWidgetItem(dateLiv));
-        tableClients->setItem(row, 7, new QTableWidgetItem(prixHT));
-        tableClients->setItem(row, 8, new QTableWidgetItem(modePaie));
-        tableClients->setItem(row, 9, new QTableWidgetItem(statut));
-        tableClients->setItem(row, 10, new QTableWidgetItem("1"));
-        tableClients->setItem(row, 11, new QTableWidgetItem(prixTTC));
+        record.id = clientStore.insert(record);
+        applyClientDelta(nullptr, &record);
+        modeleClients->recordInserted(record.id);
 
         QMessageBox::information(this, "Succès", "Client ajouté avec succès !");
     } else {
         // Modification
-        tableClients->item(currentRowClient, 1)->setText(nom);
-        tableClients->item(currentRowClient, 2)->setText(email);
-        tableClients->item(currentRowClient, 3)->setText(tel);
-        tableClients->item(currentRowClient, 4)->setText(produit);
-        tableClients->item(currentRowClient, 5)->setText(dateCmd);
-        tableClients->item(currentRowClient, 6)->setText(dateLiv);
-        tableClients->item(currentRowClient, 7)->setText(prixHT);
-        tableClients->item(currentRowClient, 8)->setText(modePaie);
-        tableClients->item(currentRowClient, 9)->setText(statut);
-        tableClients->item(currentRowClient, 11)->setText(prixTTC);
+        record.id = modeleClients->idAt(currentRowClient);
+        if (const OrderRecord *found = clientStore.find(record.id)) {
+            OrderRecord previous = *found;
+            record.quantite = previous.quantite;
+            clientStore.update(record);
+            applyClientDelta(&previous, &record);
+            modeleClients->recordUpdated(record.id);
+        }
 
         QMessageBox::information(this, "Succès", "Client modifié avec succès !");
     }
@@ -3108,7 +6160,7 @@ void MainWindow::on_btnEnregistrerClient_clicked()
 
 void MainWindow::on_btnModifierClient_clicked()
 {
-    int row = tableClients->currentRow();
+    int row = ligneCourante(tableClients);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner un client à modifier.");
         return;
@@ -3117,20 +6169,24 @@ void MainWindow::on_btnModifierClient_clicked()
     currentRowClient = row;
     stackedWidgetClients->setCurrentWidget(pageFormulaireClients);
 
-    editIDCommandeClient->setText(tableClients->item(row, 0)->text());
-    editNomClient->setText(tableClients->item(row, 1)->text());
-    editEmailClient->setText(tableClients->item(row, 2)->text());
-    editTelephoneClient->setText(tableClients->item(row, 3)->text());
-    editProduitClient->setText(tableClients->item(row, 4)->text());
-    editDateCommandeClient->setDate(QDate::fromString(tableClients->item(row, 5)->text(), "dd/MM/yyyy"));
-    editDateLivraisonClient->setDate(QDate::fromString(tableClients->item(row, 6)->text(), "dd/MM/yyyy"));
-    editPrixHTClient->setText(tableClients->item(row, 7)->text());
-    comboModePaiementClient->setCurrentText(tableClients->item(row, 8)->text());
+    editIDCommandeClient->setText(modeleClients->text(row, 0));
+    editNomClient->setText(modeleClients->text(row, 1));
+    editEmailClient->setText(modeleClients->text(row, 2));
+    editTelephoneClient->setText(modeleClients->text(row, 3));
+    editProduitClient->setText(modeleClients->text(row, 4));
+    editDateCommandeClient->setDate(QDate::fromString(modeleClients->text(row, 5), "dd/MM/yyyy"));
+    editDateLivraisonClient->setDate(QDate::fromString(modeleClients->text(row, 6), "dd/MM/yyyy"));
+    editPrixHTClient->setText(modeleClients->text(row, 7));
+    comboModePaiementClient->setCurrentText(modeleClients->text(row, 8));
+
+    if (const OrderRecord *record = clientStore.find(modeleClients->idAt(row))) {
+        editAvanceClient->setText(QString::number(record->avance, 'f', 2));
+    }
 }
 
 void MainWindow::on_btnSupprimerClient_clicked()
 {
-    int row = tableClients->currentRow();
+    int row = ligneCourante(tableClients);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner un client à supprimer.");
         return;
@@ -3141,7 +6197,13 @@ void MainWindow::on_btnSupprimerClient_clicked()
         QMessageBox::Yes | QMessageBox::No);
 
     if (reply == QMessageBox::Yes) {
-        tableClients->removeRow(row);
+        quint64 id = modeleClients->idAt(row);
+        if (const OrderRecord *found = clientStore.find(id)) {
+            OrderRecord previous = *found;
+            clientStore.remove(id);
+            applyClientDelta(&previous, nullptr);
+        }
+        modeleClients->recordRemoved(id);
         QMessageBox::information(this, "Succès", "Client supprimé avec succès !");
         updateClientStatistics();
         updateClientPerformance();
@@ -3150,7 +6212,7 @@ void MainWindow::on_btnSupprimerClient_clicked()
 
 void MainWindow::on_btnDetailsClient_clicked()
 {
-    int row = tableClients->currentRow();
+    int row = ligneCourante(tableClients);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner un client pour voir les détails.");
         return;
@@ -3158,23 +6220,25 @@ void MainWindow::on_btnDetailsClient_clicked()
 
     stackedWidgetClients->setCurrentWidget(pageDetailsClients);
 
-    detailIdCommandeClient->setText(tableClients->item(row, 0)->text());
-    detailNomClient->setText(tableClients->item(row, 1)->text());
-    detailEmailClient->setText(tableClients->item(row, 2)->text());
-    detailTelephoneClient->setText(tableClients->item(row, 3)->text());
-    detailProduitClient->setText(tableClients->item(row, 4)->text());
-    detailDateCommandeClient->setText(tableClients->item(row, 5)->text());
-    detailDateLivraisonClient->setText(tableClients->item(row, 6)->text());
-    detailPrixHTClient->setText(tableClients->item(row, 7)->text() + " DT");
-    detailModePaiementClient->setText(tableClients->item(row, 8)->text());
-    detailStatutClient->setText(tableClients->item(row, 9)->text());
-    detailQteClient->setText(tableClients->item(row, 10)->text());
-    detailPrixTTCClient->setText(tableClients->item(row, 11)->text() + " DT");
+    detailIdCommandeClient->setText(modeleClients->text(row, 0));
+    detailNomClient->setText(modeleClients->text(row, 1));
+    detailEmailClient->setText(modeleClients->text(row, 2));
+    detailTelephoneClient->setText(modeleClients->text(row, 3));
+    detailProduitClient->setText(modeleClients->text(row, 4));
+    detailDateCommandeClient->setText(modeleClients->text(row, 5));
+    detailDateLivraisonClient->setText(modeleClients->text(row, 6));
+    detailPrixHTClient->setText(modeleClients->text(row, 7) + " DT");
+    detailModePaiementClient->setText(modeleClients->text(row, 8));
+    detailStatutClient->setText(modeleClients->text(row, 9));
+    detailQteClient->setText(modeleClients->text(row, 10));
+    detailPrixTTCClient->setText(modeleClients->text(row, 11) + " DT");
 
     detailTVAClient->setText("19%");
     detailRemiseClient->setText("0%");
-    detailAvanceClient->setText("0 DT");
-    detailResteAPayerClient->setText(tableClients->item(row, 11)->text() + " DT");
+    if (const OrderRecord *record = clientStore.find(modeleClients->idAt(row))) {
+        detailAvanceClient->setText(QString::number(record->avance, 'f', 2) + " DT");
+        detailResteAPayerClient->setText(QString::number(record->resteAPayer, 'f', 2) + " DT");
+    }
 }
 
 void MainWindow::on_btnRetourDetailClient_clicked()
@@ -3184,13 +6248,16 @@ void MainWindow::on_btnRetourDetailClient_clicked()
 
 void MainWindow::searchClient()
 {
-    QString query = searchClientEdit->text().trimmed().toLower();
-
-    for (int i = 0; i < tableClients->rowCount(); ++i) {
-        QString nom = tableClients->item(i, 1)->text().toLower();
-        bool match = nom.contains(query);
-        tableClients->setRowHidden(i, !match);
+    const QString query = searchClientEdit->text().trimmed();
+    if (query.isEmpty()) {
+        filtreClients->setFilter({});
+        return;
     }
+
+    filtreClients->setFilter([this, query](int row) {
+        const OrderRecord *record = clientStore.find(modeleClients->idAt(row));
+        return record && record->nom.contains(query, Qt::CaseInsensitive);
+    });
 }
 
 void MainWindow::sortCommandesClients()
@@ -3198,153 +6265,231 @@ void MainWindow::sortCommandesClients()
     int index = comboSortClients->currentIndex();
 
     if (index == 0) {
-        tableClients->sortItems(1, Qt::AscendingOrder);
+        modeleClients->sortRecords([](const OrderRecord &a, const OrderRecord &b) {
+            return a.nom < b.nom;
+        });
     } else if (index == 1) {
-        tableClients->sortItems(1, Qt::DescendingOrder);
+        modeleClients->sortRecords([](const OrderRecord &a, const OrderRecord &b) {
+            return a.nom > b.nom;
+        });
     } else if (index == 2) {
-        tableClients->sortItems(5, Qt::DescendingOrder);
+        modeleClients->sortRecords([](const OrderRecord &a, const OrderRecord &b) {
+            return a.dateCommande > b.dateCommande;
+        });
     }
 }
 
 void MainWindow::exportFactureClientPDF()
 {
-    int row = tableClients->currentRow();
+    int row = ligneCourante(tableClients);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner une commande client.");
         return;
     }
 
     QString fileName = QFileDialog::getSaveFileName(this, "Enregistrer facture",
-                                                    "Facture_Client_" + tableClients->item(row, 1)->text() + ".pdf",
+                                                    "Facture_Client_" + modeleClients->text(row, 1) + ".pdf",
                                                     "PDF (*.pdf)");
 
     if (fileName.isEmpty()) return;
 
-    QPrinter printer(QPrinter::HighResolution);
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setOutputFileName(fileName);
-    printer.setPageSize(QPageSize(QPageSize::A4));
+    QStringList cellules;
+    for (int column = 0; column < modeleClients->columnCount(); ++column)
+        cellules.append(modeleClients->text(row, column));
 
-    QString html = "<html><head><style>"
-                   "body { font-family: Arial; margin: 40px; }"
-                   "h1 { color: #556b2f; text-align: center; }"
-                   "table { width: 100%; border-collapse: collapse; margin-top: 20px; }"
-                   "td, th { border: 1px solid #ddd; padding: 12px; text-align: left; }"
-                   "th { background-color: #f0f0f0; font-weight: bold; }"
-                   ".total { font-size: 18px; font-weight: bold; color: #556b2f; }"
-                   "</style></head><body>";
+    reportQueue->submit("Facture " + cellules.value(0), fileName,
+                        rapportHtml(factureHtml("FACTURE CLIENT", "Client", cellules)));
+}
 
-    html += "<h1>FACTURE CLIENT</h1>";
-    html += "<p><b>Date:</b> " + QDate::currentDate().toString("dd/MM/yyyy") + "</p>";
-    html += "<p><b>ID Commande:</b> " + tableClients->item(row, 0)->text() + "</p>";
+void MainWindow::exportFacturesLotClients()
+{
+    exporterFacturesLot("FACTURE CLIENT", "Client", clientStore, modeleClients);
+}
 
-    html += "<table>";
-    html += "<tr><th>Client</th><td>" + tableClients->item(row, 1)->text() + "</td></tr>";
-    html += "<tr><th>Email</th><td>" + tableClients->item(row, 2)->text() + "</td></tr>";
-    html += "<tr><th>Téléphone</th><td>" + tableClients->item(row, 3)->text() + "</td></tr>";
-    html += "<tr><th>Produit</th><td>" + tableClients->item(row, 4)->text() + "</td></tr>";
-    html += "<tr><th>Date commande</th><td>" + tableClients->item(row, 5)->text() + "</td></tr>";
-    html += "<tr><th>Date livraison</th><td>" + tableClients->item(row, 6)->text() + "</td></tr>";
-    html += "<tr><th>Prix HT</th><td>" + tableClients->item(row, 7)->text() + " DT</td></tr>";
-    html += "<tr><th>TVA</th><td>19%</td></tr>";
-    html += "<tr><th class='total'>Prix TTC</th><td class='total'>" + tableClients->item(row, 11)->text() + " DT</td></tr>";
-    html += "<tr><th>Mode de paiement</th><td>" + tableClients->item(row, 8)->text() + "</td></tr>";
-    html += "<tr><th>Statut</th><td>" + tableClients->item(row, 9)->text() + "</td></tr>";
-    html += "</table>";
+void MainWindow::updateClientStatistics()
+{
+    // Compteurs maintenus par delta : aucun parcours de la table
+    const OrderCounters &counters = clientCounters;
 
-    html += "</body></html>";
+    labelTotalClients->setText("Total clients: " + QString::number(counters.total));
+    labelTotalCommandesClients->setText("Total commandes: " + QString::number(counters.total));
+    labelCommandesEnCoursClients->setText("En cours: " + QString::number(counters.enCours));
+    labelCommandesLivreesClients->setText("Livrées: " + QString::number(counters.livrees));
+    labelTauxLivraisonClients->setText("Taux livraison: " + QString::number(counters.tauxLivraison(), 'f', 1) + "%");
+
+    QMap<QString, int> data;
+    int totalCount = 0;
 
-    QTextDocument doc;
-    doc.setHtml(html);
-    doc.print(&printer);
+    if (counters.enCours > 0) {
+        data["En cours"] = counters.enCours;
+        totalCount += counters.enCours;
+    }
+    if (counters.livrees > 0) {
+        data["Livrées"] = counters.livrees;
+        totalCount += counters.livrees;
+    }
 
-    QMessageBox::information(this, "Succès", "Facture exportée avec succès !");
-    QDesktopServices::openUrl(QUrl::fromLocalFile(fileName));
+    if (!data.isEmpty()) {
+        chartClients->setData(std::move(data), totalCount);
+    }
 }
 
-void MainWindow::updateClientStatistics()
+void MainWindow::updateClientPerformance()
 {
-    int totalClients = tableClients->rowCount();
-    int totalCommandes = totalClients;
-    int enCours = 0;
-    int livrees = 0;
+    // Le meilleur client est celui du plus gros chiffre d'affaires TTC
+    QString meilleur = "-";
+    const QVector<ClientRevenueIndex::RankedEntry> meilleurs = clientRevenus.top(ClientRevenueIndex::ChiffreAffaires, 1);
+    if (!meilleurs.isEmpty()) {
+        meilleur = QString("%1 (%2 DT TTC, %3 commandes)")
+                       .arg(meilleurs.first().nom)
+                       .arg(QString::number(meilleurs.first().stats.chiffreAffaires, 'f', 2))
+                       .arg(meilleurs.first().stats.commandes);
+    }
 
-    for (int i = 0; i < tableClients->rowCount(); ++i) {
-        QString statut = tableClients->item(i, 9)->text();
-        if (statut == "En cours") {
-            enCours++;
-        } else if (statut == "Livrée") {
-            livrees++;
-        }
+    labelMeilleurClient->setText("🏆 Meilleur client: " + meilleur);
+
+    QString rapide = "-";
+    const QVector<LeadTimeIndex::RankedEntry> premiers = clientDelais.ranking(1);
+    if (!premiers.isEmpty()) {
+        rapide = QString("%1 (médiane %2 j, p90 %3 j)")
+                     .arg(premiers.first().nom)
+                     .arg(premiers.first().summary.p50)
+                     .arg(premiers.first().summary.p90);
     }
+    labelClientRapide->setText("⚡ Client le plus rapide: " + rapide);
+
+    updateClassementClients();
+    updateEncours(tableEncoursClients, clientEncours);
+}
 
-    double tauxLivraison = (totalCommandes > 0) ? (livrees * 100.0 / totalCommandes) : 0.0;
+void MainWindow::appliquerTransitionsDatees()
+{
+    const QDate today = QDate::currentDate();
 
-    labelTotalClients->setText("Total clients: " + QString::number(totalClients));
-    labelTotalCommandesClients->setText("Total commandes: " + QString::number(totalCommandes));
-    labelCommandesEnCoursClients->setText("En cours: " + QString::number(enCours));
-    labelCommandesLivreesClients->setText("Livrées: " + QString::number(livrees));
-    labelTauxLivraisonClients->setText("Taux livraison: " + QString::number(tauxLivraison, 'f', 1) + "%");
+    // Seules les commandes dont la date de livraison est échue sont visitées
+    livrerCommandesEchues(fournisseurStore, livraisonsFournisseurs, modeleFournisseurs,
+                          &MainWindow::applyFournisseurDelta, today);
+    livrerCommandesEchues(clientStore, livraisonsClients, modeleClients,
+                          &MainWindow::applyClientDelta, today);
 
-    QMap<QString, int> data;
-    int totalCount = 0;
+    // Compteurs, encours et tranches d'âge avancent au même jour
+    rafraichirStatistiques();
 
-    if (enCours > 0) {
-        data["En cours"] = enCours;
-        totalCount += enCours;
+    const QDateTime now = QDateTime::currentDateTime();
+    const QDateTime minuit(today.addDays(1), QTime(0, 0));
+    timerStatuts->start(int(now.msecsTo(minuit)) + 1000);
+}
+
+void MainWindow::rafraichirStatistiques()
+{
+    // Les pages pas encore construites se mettront à jour à leur ouverture
+    if (pageFournisseurs) {
+        updateFournisseurStatistics();
+        updatePerformanceMetrics();
     }
-    if (livrees > 0) {
-        data["Livrées"] = livrees;
-        totalCount += livrees;
+    if (pageClients) {
+        updateClientStatistics();
+        updateClientPerformance();
     }
+    if (pageEmployes)
+        updateStatistics();
+}
 
-    if (!data.isEmpty()) {
-        chartClients->setData(data, totalCount);
+int MainWindow::livrerCommandesEchues(OrderStore &store, DateSchedule &livraisons,
+                                      OrderTableModel *modele,
+                                      void (MainWindow::*applyDelta)(const OrderRecord *, const OrderRecord *),
+                                      const QDate &today)
+{
+    int livrees = 0;
+    const QVector<quint64> echues = livraisons.takeDue(today);
+    for (quint64 id : echues) {
+        const OrderRecord *found = store.find(id);
+        if (!found || found->statut != "En cours")
+            continue;
+
+        const OrderRecord previous = *found;
+        OrderRecord record = previous;
+        record.statut = "Livrée";
+        store.update(record);
+        (this->*applyDelta)(&previous, &record);
+        modele->recordUpdated(id);
+        ++livrees;
     }
+    return livrees;
 }
 
-void MainWindow::updateClientPerformance()
+void MainWindow::updateEncours(QTableWidget *table, AgingIndex &index)
 {
-    tablePerformanceClients->setRowCount(0);
+    // Roll-forward : seules les commandes ayant changé de tranche sont déplacées
+    index.advanceTo(QDate::currentDate());
 
-    QMap<QString, int> commandesTotales;
-    QMap<QString, int> commandesLivrees;
+    const QMap<QString, AgingIndex::Exposure> &partenaires = index.parPartenaire();
+    table->setRowCount(partenaires.size() + 1);
 
-    for (int i = 0; i < tableClients->rowCount(); ++i) {
-        QString nom = tableClients->item(i, 1)->text();
-        QString statut = tableClients->item(i, 9)->text();
+    auto fillRow = [table](int row, const QString &nom, const AgingIndex::Exposure &exposure) {
+        table->setItem(row, 0, new QTableWidgetItem(nom));
+        for (int bucket = 0; bucket < AgingIndex::BucketCount; ++bucket)
+            table->setItem(row, bucket + 1, new QTableWidgetItem(QString::number(exposure.montants[bucket], 'f', 2)));
+        table->setItem(row, AgingIndex::BucketCount + 1, new QTableWidgetItem(QString::number(exposure.total(), 'f', 2)));
+    };
 
-        commandesTotales[nom]++;
-        if (statut == "Livrée") {
-            commandesLivrees[nom]++;
-        }
-    }
+    int row = 0;
+    for (auto it = partenaires.constBegin(); it != partenaires.constEnd(); ++it)
+        fillRow(row++, it.key(), it.value());
+    fillRow(row, "Total", index.global());
 
-    for (auto it = commandesTotales.begin(); it != commandesTotales.end(); ++it) {
-        QString nom = it.key();
-        int total = it.value();
-        int livrees = commandesLivrees.value(nom, 0);
-        double taux = (total > 0) ? (livrees * 100.0 / total) : 0.0;
+    QFont bold = table->font();
+    bold.setBold(true);
+    for (int column = 0; column < table->columnCount(); ++column)
+        table->item(row, column)->setFont(bold);
+}
 
-        int row = tablePerformanceClients->rowCount();
-        tablePerformanceClients->insertRow(row);
-        tablePerformanceClients->setItem(row, 0, new QTableWidgetItem(nom));
-        tablePerformanceClients->setItem(row, 1, new QTableWidgetItem(QString::number(total)));
-        tablePerformanceClients->setItem(row, 2, new QTableWidgetItem(QString::number(livrees)));
-        tablePerformanceClients->setItem(row, 3, new QTableWidgetItem(QString::number(taux, 'f', 1) + "%"));
+void MainWindow::updateClassementClients()
+{
+    const ClientRevenueIndex::Critere critere =
+        ClientRevenueIndex::Critere(comboClassementClients->currentData().toInt());
+    const QVector<ClientRevenueIndex::RankedEntry> classement = clientRevenus.top(critere, 10);
+
+    tableClassementClients->setRowCount(classement.size());
+    for (int row = 0; row < classement.size(); ++row) {
+        const ClientRevenueIndex::RankedEntry &entry = classement[row];
+        tableClassementClients->setItem(row, 0, new QTableWidgetItem(QString::number(row + 1)));
+        tableClassementClients->setItem(row, 1, new QTableWidgetItem(entry.nom));
+        tableClassementClients->setItem(row, 2, new QTableWidgetItem(QString::number(entry.stats.chiffreAffaires, 'f', 2)));
+        tableClassementClients->setItem(row, 3, new QTableWidgetItem(QString::number(entry.stats.commandes)));
+        tableClassementClients->setItem(row, 4, new QTableWidgetItem(QString::number(entry.stats.panierMoyen(), 'f', 2)));
     }
+}
 
-    QString meilleur = "-";
-    int maxCommandes = 0;
-    for (auto it = commandesTotales.begin(); it != commandesTotales.end(); ++it) {
-        if (it.value() > maxCommandes) {
-            maxCommandes = it.value();
-            meilleur = it.key();
-        }
+void MainWindow::applyClientDelta(const OrderRecord *before, const OrderRecord *after)
+{
+    if (before) {
+        clientCounters.remove(*before);
+        clientPerformance.remove(*before);
+        clientDelais.remove(*before);
+        clientEncours.remove(before->id);
+        if (before->statut == "En cours")
+            livraisonsClients.cancel(before->dateLivraison, before->id);
+        clientRevenus.remove(*before);
+        ventes.removeVente(*before);
+    }
+    if (after) {
+        clientCounters.add(*after);
+        clientPerformance.add(*after);
+        clientDelais.add(*after);
+        clientEncours.insert(*after);
+        if (after->statut == "En cours")
+            livraisonsClients.schedule(after->dateLivraison, after->id);
+        clientRevenus.add(*after);
+        ventes.addVente(*after);
     }
 
-    labelMeilleurClient->setText("🏆 Meilleur client: " + meilleur + " (" + QString::number(maxCommandes) + " commandes)");
-    labelClientRapide->setText("⚡ Client le plus rapide: " + meilleur);
+    if (before) {
+        modelePerformanceClients->partnerChanged(before->nom);
+    }
+    if (after && (!before || after->nom != before->nom)) {
+        modelePerformanceClients->partnerChanged(after->nom);
+    }
 }
 
 void MainWindow::calculatePrixTTCClient()
@@ -3409,16 +6554,7 @@ void MainWindow::showCurrentQuizQuestion()
         }
 
         quizFeedbackLabel->setText(emoji + " " + message + "\n" + commentaire);
-        quizFeedbackLabel->setStyleSheet(
-            "QLabel { "
-            "font-size: 16px; "
-            "color: #2c3e50; "
-            "padding: 20px; "
-            "background-color: #e8f5e9; "
-            "border-radius: 8px; "
-            "font-weight: bold; "
-            "}"
-            );
+        OliveraqTheme::apply(quizFeedbackLabel, OliveraqTheme::RetourBilan);
         quizFeedbackLabel->show();
         return;
     }
@@ -3475,28 +6611,10 @@ void MainWindow::handleQuizNext()
         if (correct) {
             quizScore++;
             quizFeedbackLabel->setText("✅ Correct ! " + q.explanation);
-            quizFeedbackLabel->setStyleSheet(
-                "QLabel { "
-                "font-size: 13px; "
-                "color: #2e7d32; "
-                "padding: 12px; "
-                "background-color: #e8f5e9; "
-                "border-radius: 6px; "
-                "border-left: 4px solid #4caf50; "
-                "}"
-                );
+            OliveraqTheme::apply(quizFeedbackLabel, OliveraqTheme::RetourSucces);
         } else {
             quizFeedbackLabel->setText("❌ Incorrect. " + q.explanation);
-            quizFeedbackLabel->setStyleSheet(
-                "QLabel { "
-                "font-size: 13px; "
-                "color: #c62828; "
-                "padding: 12px; "
-                "background-color: #ffebee; "
-                "border-radius: 6px; "
-                "border-left: 4px solid #f44336; "
-                "}"
-                );
+            OliveraqTheme::apply(quizFeedbackLabel, OliveraqTheme::RetourErreur);
         }
 
         quizFeedbackLabel->show();
@@ -3532,20 +6650,6 @@ void MainWindow::clearFieldsStock()
     editDateExpirationStock->setDate(QDate::currentDate().addYears(2));
 }
 
-void MainWindow::updateTableRowStock(int row)
-{
-    if (row < 0 || row >= tableProductions->rowCount()) return;
-
-    tableProductions->item(row, 1)->setText(editIdentifiantStock->text());
-    tableProductions->item(row, 2)->setText(editDateProductionStock->date().toString("dd/MM/yyyy"));
-    tableProductions->item(row, 3)->setText(comboTypeProduitStock->currentText());
-    tableProductions->item(row, 4)->setText(editQuantiteMatiereStock->text());
-    tableProductions->item(row, 5)->setText(editQuantiteProduiteStock->text());
-    tableProductions->item(row, 6)->setText(editRendementStock->text());
-    tableProductions->item(row, 7)->setText(editLotProductionStock->text());
-    tableProductions->item(row, 8)->setText(comboQualiteStock->currentText());
-}
-
 void MainWindow::on_btnListeStock_clicked()
 {
     // All sections are now always visible, no navigation needed
@@ -3625,31 +6729,34 @@ void MainWindow::on_btnEnregistrerStock_clicked()
         on_btnCalculerRendementStock_clicked();
     }
     
+    ProductionRecord record;
+    record.identifiant = identifiant;
+    record.dateProduction = dateProduction;
+    record.typeProduit = typeProduit;
+    record.quantiteMatiere = qteMatiere;
+    record.quantiteProduite = qteProduite;
+    record.rendement = (typeProduit == "Olive") ? 0.0 : editRendementStock->text().toDouble();
+    record.lot = lotProduction;
+    record.qualite = (typeProduit == "Olive") ? QString() : comboQualiteStock->currentText();
+    record.dateExpiration = editDateExpirationStock->date();
+
     // EDIT MODE
     if (currentRowStock >= 0) {
-        updateTableRowStock(currentRowStock);
+        record.id = modeleProductions->idAt(currentRowStock);
+        if (const ProductionRecord *found = productionStore.find(record.id)) {
+            const ProductionRecord previous = *found;
+            productionStore.update(record);
+            applyProductionDelta(&previous, &record);
+        }
+        modeleProductions->recordUpdated(record.id);
         QMessageBox::information(this, "Succès", "Production modifiée avec succès!");
     }
     // ADD MODE
     else {
-        int row = tableProductions->rowCount();
-        tableProductions->insertRow(row);
-
-        tableProductions->setItem(row, 0, new QTableWidgetItem(QString::number(row + 1)));
-        tableProductions->setItem(row, 1, new QTableWidgetItem(identifiant));
-        tableProductions->setItem(row, 2, new QTableWidgetItem(dateProduction.toString("dd/MM/yyyy")));
-        tableProductions->setItem(row, 3, new QTableWidgetItem(typeProduit));
-        tableProductions->setItem(row, 4, new QTableWidgetItem(quantiteMatiere));
-        // For Olive, quantity produced is empty, for others use entered value
-        QString qteProduiteText = (typeProduit == "Olive") ? "-" : quantiteProduite;
-        tableProductions->setItem(row, 5, new QTableWidgetItem(qteProduiteText));
-        // For Olive, rendement is empty, for others use calculated value
-        QString rendementText = (typeProduit == "Olive") ? "-" : editRendementStock->text();
-        tableProductions->setItem(row, 6, new QTableWidgetItem(rendementText));
-        tableProductions->setItem(row, 7, new QTableWidgetItem(lotProduction));
-        // For Olive, qualité is empty, for others use selected value
-        QString qualiteText = (typeProduit == "Olive") ? "-" : comboQualiteStock->currentText();
-        tableProductions->setItem(row, 8, new QTableWidgetItem(qualiteText));
+        quint64 id = productionStore.insert(record);
+        record.id = id;
+        applyProductionDelta(nullptr, &record);
+        modeleProductions->recordInserted(id);
 
         // Update search combo if new type
         if (comboRechercheTypeStock->findText(typeProduit) == -1) {
@@ -3667,25 +6774,25 @@ void MainWindow::on_btnEnregistrerStock_clicked()
 
 void MainWindow::on_btnModifierStock_clicked()
 {
-    int row = tableProductions->currentRow();
+    int row = ligneCourante(tableProductions);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner une production.");
         return;
     }
 
     currentRowStock = row;
-    editIdentifiantStock->setText(tableProductions->item(row, 1)->text());
-    editDateProductionStock->setDate(QDate::fromString(tableProductions->item(row, 2)->text(), "dd/MM/yyyy"));
+    editIdentifiantStock->setText(modeleProductions->text(row, 1));
+    editDateProductionStock->setDate(QDate::fromString(modeleProductions->text(row, 2), "dd/MM/yyyy"));
     
     // Find and set type produit
-    QString typeProduit = tableProductions->item(row, 3)->text();
+    QString typeProduit = modeleProductions->text(row, 3);
     int index = comboTypeProduitStock->findText(typeProduit);
     if (index >= 0) comboTypeProduitStock->setCurrentIndex(index);
     
-    editQuantiteMatiereStock->setText(tableProductions->item(row, 4)->text());
+    editQuantiteMatiereStock->setText(modeleProductions->text(row, 4));
     
     // Set quantity produced (handle "-" for Olive)
-    QString qteProduite = tableProductions->item(row, 5)->text();
+    QString qteProduite = modeleProductions->text(row, 5);
     if (qteProduite == "-") {
         editQuantiteProduiteStock->clear();
     } else {
@@ -3693,17 +6800,17 @@ void MainWindow::on_btnModifierStock_clicked()
     }
     
     // Set rendement (handle "-" for Olive)
-    QString rendement = tableProductions->item(row, 6)->text();
+    QString rendement = modeleProductions->text(row, 6);
     if (rendement == "-") {
         editRendementStock->clear();
     } else {
         editRendementStock->setText(rendement);
     }
     
-    editLotProductionStock->setText(tableProductions->item(row, 7)->text());
+    editLotProductionStock->setText(modeleProductions->text(row, 7));
     
     // Find and set qualité (handle "-" for Olive)
-    QString qualite = tableProductions->item(row, 8)->text();
+    QString qualite = modeleProductions->text(row, 8);
     if (qualite == "-") {
         comboQualiteStock->setCurrentIndex(0);
     } else {
@@ -3712,7 +6819,7 @@ void MainWindow::on_btnModifierStock_clicked()
     }
 
     // Set expiration date (default to 2 years from production date)
-    QDate prodDate = QDate::fromString(tableProductions->item(row, 2)->text(), "dd/MM/yyyy");
+    QDate prodDate = QDate::fromString(modeleProductions->text(row, 2), "dd/MM/yyyy");
     editDateExpirationStock->setDate(prodDate.addYears(2));
     
     // Trigger the type change handler to update UI state
@@ -3721,7 +6828,7 @@ void MainWindow::on_btnModifierStock_clicked()
 
 void MainWindow::on_btnSupprimerStock_clicked()
 {
-    int row = tableProductions->currentRow();
+    int row = ligneCourante(tableProductions);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner une production.");
         return;
@@ -3731,12 +6838,13 @@ void MainWindow::on_btnSupprimerStock_clicked()
                               "Voulez-vous vraiment supprimer cette production ?",
                               QMessageBox::Yes | QMessageBox::No) == QMessageBox::Yes)
     {
-        tableProductions->removeRow(row);
-        
-        // Update IDs
-        for (int i = row; i < tableProductions->rowCount(); ++i) {
-            tableProductions->item(i, 0)->setText(QString::number(i + 1));
+        const quint64 id = modeleProductions->idAt(row);
+        if (const ProductionRecord *found = productionStore.find(id)) {
+            const ProductionRecord previous = *found;
+            productionStore.remove(id);
+            applyProductionDelta(&previous, nullptr);
         }
+        modeleProductions->recordRemoved(id);
         
         // Update statistics
         genererStatistiquesStock();
@@ -3745,22 +6853,22 @@ void MainWindow::on_btnSupprimerStock_clicked()
 
 void MainWindow::on_btnDetailsStock_clicked()
 {
-    int row = tableProductions->currentRow();
+    int row = ligneCourante(tableProductions);
     if (row < 0) {
         QMessageBox::warning(this, "Erreur", "Veuillez sélectionner une production.");
         return;
     }
 
     // Get data directly from table
-    QString id = tableProductions->item(row, 0)->text();
-    QString identifiant = tableProductions->item(row, 1)->text();
-    QString dateProduction = tableProductions->item(row, 2)->text();
-    QString typeProduit = tableProductions->item(row, 3)->text();
-    QString quantiteMatiere = tableProductions->item(row, 4)->text();
-    QString quantiteProduite = tableProductions->item(row, 5)->text();
-    QString rendement = tableProductions->item(row, 6)->text();
-    QString lot = tableProductions->item(row, 7)->text();
-    QString qualite = tableProductions->item(row, 8)->text();
+    QString id = QString::number(tableProductions->currentIndex().row() + 1);
+    QString identifiant = modeleProductions->text(row, 1);
+    QString dateProduction = modeleProductions->text(row, 2);
+    QString typeProduit = modeleProductions->text(row, 3);
+    QString quantiteMatiere = modeleProductions->text(row, 4);
+    QString quantiteProduite = modeleProductions->text(row, 5);
+    QString rendement = modeleProductions->text(row, 6);
+    QString lot = modeleProductions->text(row, 7);
+    QString qualite = modeleProductions->text(row, 8);
     
     // Calculate expiration date (default to 2 years from production date)
     QDate prodDate = QDate::fromString(dateProduction, "dd/MM/yyyy");
@@ -3871,126 +6979,309 @@ void MainWindow::on_comboTypeProduitStock_currentIndexChanged(int index)
 
 void MainWindow::filtrerParTypeStock()
 {
-    QString typeFiltre = comboRechercheTypeStock->currentText();
-    
+    const QString typeFiltre = comboRechercheTypeStock->currentText();
     if (typeFiltre == "Tous") {
-        // Show all rows
-        for (int i = 0; i < tableProductions->rowCount(); ++i) {
-            tableProductions->setRowHidden(i, false);
-        }
-    } else {
-        // Hide rows that don't match the filter
-        for (int i = 0; i < tableProductions->rowCount(); ++i) {
-            QTableWidgetItem* item = tableProductions->item(i, 3);
-            if (item) {
-                QString typeProduit = item->text();
-                tableProductions->setRowHidden(i, typeProduit != typeFiltre);
-            } else {
-                tableProductions->setRowHidden(i, true);
-            }
-        }
+        filtreProductions->setFilter({});
+        return;
     }
+
+    filtreProductions->setFilter([this, typeFiltre](int row) {
+        const ProductionRecord *record = productionStore.find(modeleProductions->idAt(row));
+        return record && record->typeProduit == typeFiltre;
+    });
 }
 
 void MainWindow::trierTableauStock()
 {
     QString triSelection = comboTriStock->currentText();
-    
-    // Disable automatic sorting temporarily
-    tableProductions->setSortingEnabled(false);
-    
-    // Get all rows data
-    QList<QList<QTableWidgetItem*>> rows;
-    for (int i = 0; i < tableProductions->rowCount(); ++i) {
-        QList<QTableWidgetItem*> row;
-        for (int j = 0; j < tableProductions->columnCount(); ++j) {
-            QTableWidgetItem* item = tableProductions->item(i, j);
-            if (item) {
-                row.append(new QTableWidgetItem(*item));
-            } else {
-                row.append(new QTableWidgetItem(""));
-            }
-        }
-        rows.append(row);
-    }
-    
-    // Sort based on selection
+
+    // Tri des identifiants dans le modèle : aucune cellule n'est recopiée.
+    // Les dates invalides sont placées en fin de liste.
     if (triSelection == "Date (croissant)") {
-        std::sort(rows.begin(), rows.end(), [](const QList<QTableWidgetItem*>& a, const QList<QTableWidgetItem*>& b) {
-            if (a.size() <= 2 || b.size() <= 2) return false;
-            QDate dateA = QDate::fromString(a[2]->text(), "dd/MM/yyyy");
-            QDate dateB = QDate::fromString(b[2]->text(), "dd/MM/yyyy");
-            if (!dateA.isValid()) return false;
-            if (!dateB.isValid()) return true;
-            return dateA < dateB;
+        modeleProductions->sortRecords([](const ProductionRecord &a, const ProductionRecord &b) {
+            if (!a.dateProduction.isValid()) return false;
+            if (!b.dateProduction.isValid()) return true;
+            return a.dateProduction < b.dateProduction;
         });
     } else if (triSelection == "Date (décroissant)") {
-        std::sort(rows.begin(), rows.end(), [](const QList<QTableWidgetItem*>& a, const QList<QTableWidgetItem*>& b) {
-            if (a.size() <= 2 || b.size() <= 2) return false;
-            QDate dateA = QDate::fromString(a[2]->text(), "dd/MM/yyyy");
-            QDate dateB = QDate::fromString(b[2]->text(), "dd/MM/yyyy");
-            if (!dateA.isValid()) return false;
-            if (!dateB.isValid()) return true;
-            return dateA > dateB;
+        modeleProductions->sortRecords([](const ProductionRecord &a, const ProductionRecord &b) {
+            if (!a.dateProduction.isValid()) return false;
+            if (!b.dateProduction.isValid()) return true;
+            return a.dateProduction > b.dateProduction;
         });
     } else if (triSelection == "Type produit") {
-        std::sort(rows.begin(), rows.end(), [](const QList<QTableWidgetItem*>& a, const QList<QTableWidgetItem*>& b) {
-            if (a.size() <= 3 || b.size() <= 3) return false;
-            return a[3]->text() < b[3]->text();
+        modeleProductions->sortRecords([](const ProductionRecord &a, const ProductionRecord &b) {
+            return a.typeProduit < b.typeProduit;
         });
     }
-    
-    // Clear and repopulate table
-    tableProductions->setRowCount(0);
-    for (int i = 0; i < rows.size(); ++i) {
-        int row = tableProductions->rowCount();
-        tableProductions->insertRow(row);
-        for (int j = 0; j < rows[i].size(); ++j) {
-            tableProductions->setItem(row, j, rows[i][j]);
-        }
-        // Update ID
-        tableProductions->item(row, 0)->setText(QString::number(i + 1));
-    }
-    
-    // Re-enable sorting
-    tableProductions->setSortingEnabled(true);
-    
+
     // Update statistics after sorting
     genererStatistiquesStock();
 }
 
 void MainWindow::genererStatistiquesStock()
 {
+    // Le camembert lit les totaux par type dans le cube, en respectant le
+    // filtre de type de la liste
     QMap<QString, int> statsCount;
     int totalProductions = 0;
-    
-    // Count productions by type
-    for (int i = 0; i < tableProductions->rowCount(); ++i) {
-        if (!tableProductions->isRowHidden(i)) {
-            QString typeProduit = tableProductions->item(i, 3)->text();
-            
-            // Use the type directly as category
-            QString category = typeProduit;
-            
-            // Normalize category names
-            if (category.contains("Huile d'olive", Qt::CaseInsensitive)) {
-                category = "Huile d'olive";
-            } else if (category.contains("Huile végétale", Qt::CaseInsensitive) || 
-                      category.contains("Huile vegetale", Qt::CaseInsensitive)) {
-                category = "Huile végétale";
-            } else if (category.contains("Olive", Qt::CaseInsensitive)) {
-                category = "Olive";
-            }
-            
-            statsCount[category]++;
-            totalProductions++;
-        }
+
+    const QString typeFiltre = comboRechercheTypeStock->currentText();
+    const QVector<ProductionCube::Member> types = productionCube.drillDown(ProductionCube::Slice(), ProductionCube::DimType);
+    for (const ProductionCube::Member &member : types) {
+        if (typeFiltre != "Tous" && member.slice.type != typeFiltre)
+            continue;
+        statsCount[member.libelle] += member.mesures.count;
+        totalProductions += member.mesures.count;
     }
-    
+
     // Update pie chart widget with the categories
     if (pieChartWidgetStock) {
-        pieChartWidgetStock->setData(statsCount, totalProductions);
+        pieChartWidgetStock->setData(std::move(statsCount), totalProductions);
+    }
+}
+
+void MainWindow::applyProductionDelta(const ProductionRecord *before, const ProductionRecord *after)
+{
+    if (before) {
+        productionCube.remove(*before);
+        productionSeries.remove(*before);
+        rendementAnalytics.remove(*before);
+    }
+    if (after) {
+        productionCube.add(*after);
+        productionSeries.add(*after);
+        rendementAnalytics.add(*after);
+    }
+
+    updateCubeStock();
+    updateCourbesStock();
+    updateRendementsStock();
+}
+
+void MainWindow::updateTableauVentes()
+{
+    // Lecture des agrégats uniquement : aucune commande n'est parcourue
+    const SalesEngine::Totaux &totaux = ventes.totaux();
+    labelVentesCA->setText(QString("Chiffre d'affaires: %1 DT TTC (%2 commandes)")
+                               .arg(QString::number(totaux.ventesTTC, 'f', 2))
+                               .arg(totaux.commandes));
+    labelVentesMarge->setText(QString("Marge: %1 DT (%2%)")
+                                  .arg(QString::number(totaux.marge(), 'f', 2))
+                                  .arg(QString::number(totaux.tauxMarge(), 'f', 1)));
+    labelVentesEncaisse->setText("Encaissé: " + QString::number(totaux.encaisse, 'f', 2) + " DT");
+    labelVentesReste->setText("Reste à encaisser: " + QString::number(totaux.resteAEncaisser, 'f', 2) + " DT");
+
+    QStringList jours;
+    LineChartWidget::Series chiffreAffaires{"Ventes TTC (DT)", QColor(92, 122, 58), {}};
+    const QMap<QDate, SalesEngine::Jour> &parJour = ventes.ventesParJour();
+    chiffreAffaires.valeurs.reserve(parJour.size());
+    for (auto it = parJour.constBegin(); it != parJour.constEnd(); ++it) {
+        jours << it.key().toString("dd/MM/yyyy");
+        chiffreAffaires.valeurs.append(it.value().ventesTTC);
+    }
+    chartVentesJour->setData(jours, {chiffreAffaires});
+
+    const QVector<SalesEngine::RankedProduit> produits = ventes.topProduits(10);
+    tableTopProduits->setRowCount(produits.size());
+    for (int row = 0; row < produits.size(); ++row) {
+        const SalesEngine::ProduitStats &stats = produits[row].stats;
+        tableTopProduits->setItem(row, 0, new QTableWidgetItem(produits[row].produit));
+        tableTopProduits->setItem(row, 1, new QTableWidgetItem(QString::number(stats.commandes)));
+        tableTopProduits->setItem(row, 2, new QTableWidgetItem(QString::number(stats.quantite)));
+        tableTopProduits->setItem(row, 3, new QTableWidgetItem(QString::number(stats.ventesTTC, 'f', 2)));
+        tableTopProduits->setItem(row, 4, new QTableWidgetItem(QString::number(stats.achatsHT, 'f', 2)));
+        tableTopProduits->setItem(row, 5, new QTableWidgetItem(QString::number(stats.marge(), 'f', 2)));
+    }
+}
+
+StoreSnapshot MainWindow::snapshotStores() const
+{
+    return StoreSnapshot{employeeStore, fournisseurStore, clientStore, productionStore};
+}
+
+void MainWindow::rebuildProductionAnalyticsAsync()
+{
+    const quint64 version = productionStore.version();
+
+    analyticsExecutor->submit("productions", snapshotStores(),
+                              [this, version](const StoreSnapshot &snapshot, const std::atomic_bool &cancelled)
+                                  -> AnalyticsExecutor::Publisher {
+        // Calcul sur le thread du pool : uniquement la copie, aucun widget
+        struct Result
+        {
+            ProductionCube cube;
+            ProductionTimeSeries series;
+            YieldAnalytics rendements;
+        };
+        auto result = std::make_shared<Result>();
+
+        int visited = 0;
+        for (const ProductionRecord &record : snapshot.productions.records()) {
+            if ((++visited & 0xFFF) == 0 && cancelled)
+                return {};
+            result->cube.add(record);
+            result->rendements.add(record);
+        }
+        result->series.rebuild(snapshot.productions);
+
+        return [this, version, result]() {
+            // Le store a changé pendant le calcul : on relance sur une copie à jour
+            if (productionStore.version() != version) {
+                rebuildProductionAnalyticsAsync();
+                return;
+            }
+            productionCube = std::move(result->cube);
+            productionSeries = std::move(result->series);
+            rendementAnalytics = std::move(result->rendements);
+
+            if (!pageStocks)
+                return;
+            genererStatistiquesStock();
+            updateCubeStock();
+            updateCourbesStock();
+            updateRendementsStock();
+        };
+    });
+}
+
+void MainWindow::updateRendementsStock()
+{
+    QStringList classes;
+    for (int i = 0; i < YieldAnalytics::NombreClasses; ++i) {
+        const double debut = i * YieldAnalytics::LargeurClasse;
+        classes << (i == YieldAnalytics::NombreClasses - 1
+                        ? QString("≥ %1").arg(debut, 0, 'f', 1)
+                        : QString("%1-%2").arg(debut, 0, 'f', 1).arg(debut + YieldAnalytics::LargeurClasse, 0, 'f', 1));
+    }
+    histogramRendementStock->setData(classes, rendementAnalytics.histogram());
+
+    const QVector<YieldAnalytics::GroupStats> groups = rendementAnalytics.groups();
+    tableRendementsStock->setRowCount(groups.size());
+    for (int row = 0; row < groups.size(); ++row) {
+        const YieldAnalytics::GroupStats &group = groups[row];
+        tableRendementsStock->setItem(row, 0, new QTableWidgetItem(group.type));
+        tableRendementsStock->setItem(row, 1, new QTableWidgetItem(group.mois == 0 ? QString("Tous")
+                                                                                  : ProductionCube::moisLibelle(group.mois)));
+        tableRendementsStock->setItem(row, 2, new QTableWidgetItem(QString::number(group.moments.n)));
+        tableRendementsStock->setItem(row, 3, new QTableWidgetItem(QString::number(group.moments.mean, 'f', 2)));
+        tableRendementsStock->setItem(row, 4, new QTableWidgetItem(QString::number(group.moments.stddev(), 'f', 2)));
+    }
+
+    const QVector<YieldAnalytics::Outlier> outliers = rendementAnalytics.outliers();
+    tableLotsAtypiquesStock->setRowCount(outliers.size());
+    for (int row = 0; row < outliers.size(); ++row) {
+        const YieldAnalytics::Outlier &outlier = outliers[row];
+        const ProductionRecord *record = productionStore.find(outlier.id);
+        tableLotsAtypiquesStock->setItem(row, 0, new QTableWidgetItem(record ? record->identifiant : QString("-")));
+        tableLotsAtypiquesStock->setItem(row, 1, new QTableWidgetItem(outlier.type));
+        tableLotsAtypiquesStock->setItem(row, 2, new QTableWidgetItem(record ? record->dateProduction.toString("dd/MM/yyyy") : QString("-")));
+        tableLotsAtypiquesStock->setItem(row, 3, new QTableWidgetItem(QString::number(outlier.rendement, 'f', 2)));
+        tableLotsAtypiquesStock->setItem(row, 4, new QTableWidgetItem(QString::number(outlier.zScore, 'f', 1)));
+    }
+}
+
+void MainWindow::updateCourbesStock()
+{
+    const ProductionTimeSeries::Granularity granularity =
+        ProductionTimeSeries::Granularity(comboGranulariteStock->currentData().toInt());
+    const QVector<ProductionTimeSeries::Point> points = productionSeries.series(granularity);
+    const QString format = granularity == ProductionTimeSeries::Mois ? "MM/yyyy" : "dd/MM/yyyy";
+
+    QStringList labels;
+    LineChartWidget::Series kg{"Olives reçues (KG)", QColor(92, 122, 58), {}};
+    LineChartWidget::Series litres{"Huile produite (L)", QColor(255, 152, 0), {}};
+    kg.valeurs.reserve(points.size());
+    litres.valeurs.reserve(points.size());
+    for (const ProductionTimeSeries::Point &point : points) {
+        labels << point.debut.toString(format);
+        kg.valeurs.append(point.kg);
+        litres.valeurs.append(point.litres);
+    }
+
+    lineChartWidgetStock->setData(labels, {kg, litres});
+}
+
+void MainWindow::on_comboGranulariteStock_currentIndexChanged(int index)
+{
+    Q_UNUSED(index);
+    updateCourbesStock();
+}
+
+void MainWindow::updateCubeStock()
+{
+    const ProductionCube::Dimension dimension =
+        ProductionCube::Dimension(comboCubeAxeStock->currentData().toInt());
+    const QVector<ProductionCube::Member> members = productionCube.drillDown(cubeSlice, dimension);
+
+    cubeLignes.clear();
+    tableCubeStock->setRowCount(members.size());
+    for (int row = 0; row < members.size(); ++row) {
+        const ProductionCube::Member &member = members[row];
+        const ProductionCube::Measures &mesures = member.mesures;
+        cubeLignes.append(member.slice);
+        tableCubeStock->setItem(row, 0, new QTableWidgetItem(member.libelle));
+        tableCubeStock->setItem(row, 1, new QTableWidgetItem(QString::number(mesures.count)));
+        tableCubeStock->setItem(row, 2, new QTableWidgetItem(QString::number(mesures.kg, 'f', 2)));
+        tableCubeStock->setItem(row, 3, new QTableWidgetItem(QString::number(mesures.litres, 'f', 2)));
+        tableCubeStock->setItem(row, 4, new QTableWidgetItem(mesures.rendementCount > 0
+                                                             ? QString::number(mesures.rendementMoyen(), 'f', 2)
+                                                             : QString("-")));
     }
+
+    QStringList chemin;
+    if (!cubeSlice.type.isEmpty())
+        chemin << cubeSlice.type;
+    if (cubeSlice.mois != 0)
+        chemin << ProductionCube::moisLibelle(cubeSlice.mois);
+    if (!cubeSlice.qualite.isEmpty())
+        chemin << cubeSlice.qualite;
+    labelCubeCheminStock->setText(chemin.isEmpty() ? QString("Toutes les productions") : chemin.join(" › "));
+    btnCubeRemonterStock->setEnabled(!cubeHistorique.isEmpty());
+}
+
+void MainWindow::on_comboCubeAxeStock_currentIndexChanged(int index)
+{
+    Q_UNUSED(index);
+    updateCubeStock();
+}
+
+void MainWindow::on_tableCubeStock_cellDoubleClicked(int row, int column)
+{
+    Q_UNUSED(column);
+    if (row < 0 || row >= cubeLignes.size())
+        return;
+
+    // Drill-down : on fixe le membre choisi et on passe au premier axe encore libre
+    cubeHistorique.append(qMakePair(cubeSlice, comboCubeAxeStock->currentIndex()));
+    cubeSlice = cubeLignes[row];
+
+    int prochainAxe = comboCubeAxeStock->currentIndex();
+    if (cubeSlice.type.isEmpty())
+        prochainAxe = ProductionCube::DimType;
+    else if (cubeSlice.mois == 0)
+        prochainAxe = ProductionCube::DimMois;
+    else if (cubeSlice.qualite.isEmpty())
+        prochainAxe = ProductionCube::DimQualite;
+
+    if (prochainAxe != comboCubeAxeStock->currentIndex())
+        comboCubeAxeStock->setCurrentIndex(prochainAxe);   // déclenche updateCubeStock()
+    else
+        updateCubeStock();
+}
+
+void MainWindow::on_btnCubeRemonterStock_clicked()
+{
+    if (cubeHistorique.isEmpty())
+        return;
+
+    // Roll-up : retour au niveau d'agrégation précédent
+    const QPair<ProductionCube::Slice, int> precedent = cubeHistorique.takeLast();
+    cubeSlice = precedent.first;
+    if (precedent.second != comboCubeAxeStock->currentIndex())
+        comboCubeAxeStock->setCurrentIndex(precedent.second);
+    else
+        updateCubeStock();
 }
 
 void MainWindow::on_btnExportPDFStock_clicked()
@@ -4004,34 +7295,7 @@ void MainWindow::exporterPDFStock()
     QDate currentDate = QDate::currentDate();
     QDate monthStart = QDate(currentDate.year(), currentDate.month(), 1);
     QDate monthEnd = monthStart.addMonths(1).addDays(-1);
-    
-    // Get all productions for the current month
-    QList<QList<QString>> productionsMois;
-    double totalQuantiteProduite = 0.0;
-    QMap<QString, double> quantiteParType;
-    
-    for (int i = 0; i < tableProductions->rowCount(); ++i) {
-        QString dateStr = tableProductions->item(i, 2)->text();
-        QDate dateProd = parseDateFromStringStock(dateStr);
-        
-        if (dateProd >= monthStart && dateProd <= monthEnd) {
-            QList<QString> row;
-            for (int j = 0; j < tableProductions->columnCount(); ++j) {
-                QTableWidgetItem* item = tableProductions->item(i, j);
-                row.append(item ? item->text() : "");
-            }
-            productionsMois.append(row);
-            
-            // Calculate totals
-            bool ok;
-            double qteProduite = row[5].toDouble(&ok);
-            if (ok && row[5] != "-") {
-                totalQuantiteProduite += qteProduite;
-                quantiteParType[row[3]] += qteProduite;
-            }
-        }
-    }
-    
+
     // Ask for file save location
     QString fileName = QFileDialog::getSaveFileName(this, "Exporter en PDF",
                                                     QString("Etat_Stock_%1_%2.pdf")
@@ -4042,110 +7306,159 @@ void MainWindow::exporterPDFStock()
     if (fileName.isEmpty()) {
         return;
     }
-    
-    // Create PDF
-    QPrinter printer(QPrinter::HighResolution);
-    printer.setOutputFormat(QPrinter::PdfFormat);
-    printer.setOutputFileName(fileName);
-    
-    // Set page size (Qt6 compatible)
-    #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        printer.setPageSize(QPageSize::A4);
-        printer.setPageMargins(QMarginsF(20, 20, 20, 20), QPageLayout::Millimeter);
-    #else
-        printer.setPageSize(QPrinter::A4);
-        printer.setPageMargins(20, 20, 20, 20, QPrinter::Millimeter);
-    #endif
-    
-    QPainter painter(&printer);
-    painter.setRenderHint(QPainter::Antialiasing);
-    
-    int yPos = 50;
-    // Get page height (compatible Qt5 and Qt6)
-    int resolution = printer.resolution();
-    #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        int pageHeight = static_cast<int>((297.0 - 40.0) * resolution / 25.4);
-    #else
-        int pageHeight = printer.pageRect().height();
-    #endif
-    int lineHeight = 20;
-    
-    // Title
-    QFont titleFont("Arial", 16, QFont::Bold);
-    painter.setFont(titleFont);
-    painter.drawText(50, yPos, "État de Stock - " + 
-                     monthStart.toString("MMMM yyyy"));
-    yPos += 40;
-    
-    // Summary
-    QFont normalFont("Arial", 10);
-    painter.setFont(normalFont);
-    painter.drawText(50, yPos, "Période : " + monthStart.toString("dd/MM/yyyy") + 
-                     " - " + monthEnd.toString("dd/MM/yyyy"));
-    yPos += 30;
-    painter.drawText(50, yPos, "Total quantité produite : " + 
-                     QString::number(totalQuantiteProduite, 'f', 2) + " L");
-    yPos += 30;
-    
-    // Table header
-    painter.setFont(QFont("Arial", 9, QFont::Bold));
-    int xPos = 50;
-    QStringList headers = {"ID", "Identifiant", "Date", "Type", "Qte Matière", 
-                          "Qte Produite", "Rendement", "Lot", "Qualité"};
-    int colWidths[] = {30, 100, 80, 60, 80, 80, 70, 60, 100};
-    
-    painter.drawRect(50, yPos, 700, lineHeight + 5);
-    for (int i = 0; i < headers.size(); ++i) {
-        painter.drawText(xPos + 5, yPos + 15, headers[i]);
-        xPos += colWidths[i];
-    }
-    yPos += lineHeight + 10;
-    
-    // Table rows
-    painter.setFont(QFont("Arial", 8));
-    for (const QList<QString>& row : productionsMois) {
-        if (yPos > pageHeight - 100) {
-            printer.newPage();
-            yPos = 50;
+
+    // Copies figées pour le thread du rapport : store partagé implicitement,
+    // ordre d'affichage et formatage des colonnes de la table
+    const ProductionStore store = productionStore;
+    const QVector<quint64> ids = modeleProductions->ids();
+    const QVector<ProductionTableModel::Column> colonnes = modeleProductions->columns();
+
+    auto job = [store, ids, colonnes, monthStart, monthEnd](QPrinter &printer, ReportQueue::Control &control) {
+        // Get all productions for the current month
+        QList<QList<QString>> productionsMois;
+        double totalQuantiteProduite = 0.0;
+        QMap<QString, double> quantiteParType;
+
+        for (int i = 0; i < ids.size(); ++i) {
+            if ((i & 0xFFF) == 0) {
+                if (control.cancelled())
+                    return false;
+                control.setProgress(30 * i / ids.size());
+            }
+            const ProductionRecord *record = store.find(ids[i]);
+            if (!record)
+                continue;
+            QDate dateProd = record->dateProduction;
+
+            if (dateProd >= monthStart && dateProd <= monthEnd) {
+                QList<QString> row;
+                for (const ProductionTableModel::Column &colonne : colonnes) {
+                    row.append(colonne.texte(*record));
+                }
+                row[0] = QString::number(i + 1);
+                productionsMois.append(row);
+
+                // Calculate totals
+                bool ok;
+                double qteProduite = row[5].toDouble(&ok);
+                if (ok && row[5] != "-") {
+                    totalQuantiteProduite += qteProduite;
+                    quantiteParType[row[3]] += qteProduite;
+                }
+            }
         }
-        
-        xPos = 50;
+        control.setProgress(30);
+
+        // Set page margins (Qt6 compatible)
+        #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            printer.setPageMargins(QMarginsF(20, 20, 20, 20), QPageLayout::Millimeter);
+        #else
+            printer.setPageMargins(20, 20, 20, 20, QPrinter::Millimeter);
+        #endif
+
+        QPainter painter;
+        if (!painter.begin(&printer))
+            return false;
+        painter.setRenderHint(QPainter::Antialiasing);
+
+        int yPos = 50;
+        // Get page height (compatible Qt5 and Qt6)
+        int resolution = printer.resolution();
+        #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            int pageHeight = static_cast<int>((297.0 - 40.0) * resolution / 25.4);
+        #else
+            Q_UNUSED(resolution);
+            int pageHeight = printer.pageRect().height();
+        #endif
+        int lineHeight = 20;
+
+        // Title
+        QFont titleFont("Arial", 16, QFont::Bold);
+        painter.setFont(titleFont);
+        painter.drawText(50, yPos, "État de Stock - " +
+                         monthStart.toString("MMMM yyyy"));
+        yPos += 40;
+
+        // Summary
+        QFont normalFont("Arial", 10);
+        painter.setFont(normalFont);
+        painter.drawText(50, yPos, "Période : " + monthStart.toString("dd/MM/yyyy") +
+                         " - " + monthEnd.toString("dd/MM/yyyy"));
+        yPos += 30;
+        painter.drawText(50, yPos, "Total quantité produite : " +
+                         QString::number(totalQuantiteProduite, 'f', 2) + " L");
+        yPos += 30;
+
+        // Table header
+        painter.setFont(QFont("Arial", 9, QFont::Bold));
+        int xPos = 50;
+        QStringList headers = {"ID", "Identifiant", "Date", "Type", "Qte Matière",
+                              "Qte Produite", "Rendement", "Lot", "Qualité"};
+        int colWidths[] = {30, 100, 80, 60, 80, 80, 70, 60, 100};
+
         painter.drawRect(50, yPos, 700, lineHeight + 5);
-        for (int i = 0; i < qMin(row.size(), headers.size()); ++i) {
-            QString text = row[i];
-            if (text.length() > 15) {
-                text = text.left(12) + "...";
-            }
-            painter.drawText(xPos + 5, yPos + 15, text);
+        for (int i = 0; i < headers.size(); ++i) {
+            painter.drawText(xPos + 5, yPos + 15, headers[i]);
             xPos += colWidths[i];
         }
-        yPos += lineHeight + 5;
-    }
-    
-    // Summary by type
-    yPos += 20;
-    if (yPos > pageHeight - 100) {
-        printer.newPage();
-        yPos = 50;
-    }
-    
-    painter.setFont(QFont("Arial", 10, QFont::Bold));
-    painter.drawText(50, yPos, "Résumé par type de produit :");
-    yPos += 25;
-    
-    painter.setFont(QFont("Arial", 9));
-    for (auto it = quantiteParType.begin(); it != quantiteParType.end(); ++it) {
-        double pourcentage = (it.value() * 100.0) / totalQuantiteProduite;
-        painter.drawText(50, yPos, it.key() + " : " + 
-                        QString::number(it.value(), 'f', 2) + " L (" + 
-                        QString::number(pourcentage, 'f', 2) + "%)");
+        yPos += lineHeight + 10;
+
+        // Table rows
+        painter.setFont(QFont("Arial", 8));
+        for (int r = 0; r < productionsMois.size(); ++r) {
+            // Une annulation en cours de page laisse un fichier incomplet,
+            // retiré par la file des rapports
+            if (control.cancelled()) {
+                painter.end();
+                return false;
+            }
+            control.setProgress(30 + 65 * r / productionsMois.size());
+
+            const QList<QString> &row = productionsMois[r];
+            if (yPos > pageHeight - 100) {
+                printer.newPage();
+                yPos = 50;
+            }
+
+            xPos = 50;
+            painter.drawRect(50, yPos, 700, lineHeight + 5);
+            for (int i = 0; i < qMin(row.size(), headers.size()); ++i) {
+                QString text = row[i];
+                if (text.length() > 15) {
+                    text = text.left(12) + "...";
+                }
+                painter.drawText(xPos + 5, yPos + 15, text);
+                xPos += colWidths[i];
+            }
+            yPos += lineHeight + 5;
+        }
+
+        // Summary by type
         yPos += 20;
-    }
-    
-    painter.end();
-    
-    QMessageBox::information(this, "Succès", 
-                            "Le fichier PDF a été généré avec succès !\n" + fileName);
+        if (yPos > pageHeight - 100) {
+            printer.newPage();
+            yPos = 50;
+        }
+
+        painter.setFont(QFont("Arial", 10, QFont::Bold));
+        painter.drawText(50, yPos, "Résumé par type de produit :");
+        yPos += 25;
+
+        painter.setFont(QFont("Arial", 9));
+        for (auto it = quantiteParType.begin(); it != quantiteParType.end(); ++it) {
+            double pourcentage = (it.value() * 100.0) / totalQuantiteProduite;
+            painter.drawText(50, yPos, it.key() + " : " +
+                            QString::number(it.value(), 'f', 2) + " L (" +
+                            QString::number(pourcentage, 'f', 2) + "%)");
+            yPos += 20;
+        }
+
+        painter.end();
+        control.setProgress(100);
+        return true;
+    };
+
+    reportQueue->submit("État de stock " + monthStart.toString("MM/yyyy"), fileName, job);
 }
 
 QDate MainWindow::parseDateFromStringStock(const QString &dateStr)
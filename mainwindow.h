@@ -2,10 +2,32 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QAbstractTableModel>
+#include <QAbstractProxyModel>
+#include <QBitArray>
 #include <QString>
 #include <QMap>
 #include <QColor>
+#include <QPixmap>
+#include <QFont>
+#include <QPalette>
+#include <QProxyStyle>
+#include <QRect>
+#include <QPointF>
+#include <QStringList>
 #include <QList>
+#include <QHash>
+#include <QSet>
+#include <QDate>
+#include <QVector>
+#include <QPair>
+#include <QThreadPool>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <functional>
+#include <memory>
+#include <utility>
 
 class QStackedWidget;
 class QWidget;
@@ -13,6 +35,8 @@ class QLineEdit;
 class QPushButton;
 class QComboBox;
 class QTableWidget;
+class QTableWidgetItem;
+class QTableView;
 class QSpinBox;
 class QDoubleSpinBox;
 class QDateEdit;
@@ -21,6 +45,1173 @@ class QCheckBox;
 class QRadioButton;
 class QSplitter;
 class QPaintEvent;
+class QResizeEvent;
+class QMouseEvent;
+class QPrinter;
+class QProgressBar;
+class QWheelEvent;
+class QTimer;
+
+// =======================
+// Enregistrements métier
+// =======================
+// Chaque enregistrement porte un identifiant 64 bits stable attribué par son
+// store ; il ne dépend jamais de la position de la ligne dans la table.
+
+struct EmployeeRecord
+{
+    quint64 id = 0;
+    QString nom;
+    QString prenom;
+    QString poste;
+    QString email;
+    QString telephone;
+    int salaire = 0;
+    int heures = 0;
+    QDate dateEmbauche;
+    QDate dateNaissance;
+};
+
+// Commande fournisseur ou client (même structure pour les deux modules)
+struct OrderRecord
+{
+    quint64 id = 0;
+    QString nom;
+    QString email;
+    QString telephone;
+    QString produit;
+    QDate dateCommande;
+    QDate dateLivraison;
+    double prixHT = 0.0;
+    QString modePaiement;
+    QString statut;
+    int quantite = 1;
+    double prixTTC = 0.0;
+    double avance = 0.0;
+    double resteAPayer = 0.0;
+};
+
+struct ProductionRecord
+{
+    quint64 id = 0;
+    QString identifiant;
+    QDate dateProduction;
+    QString typeProduit;
+    double quantiteMatiere = 0.0;   // KG
+    double quantiteProduite = 0.0;  // L (0 pour "Olive")
+    double rendement = 0.0;
+    QString lot;
+    QString qualite;                // vide pour "Olive"
+    QDate dateExpiration;
+};
+
+// Store en mémoire indexé par identifiant. L'allocateur est monotone : un
+// identifiant supprimé n'est jamais réattribué, il reste donc valable pour
+// le journal et les factures.
+template <typename T>
+class RecordStore
+{
+public:
+    quint64 insert(T record)
+    {
+        record.id = ++m_lastId;
+        m_records.insert(record.id, record);
+        ++m_version;
+        return record.id;
+    }
+
+    bool update(const T &record)
+    {
+        auto it = m_records.find(record.id);
+        if (it == m_records.end())
+            return false;
+        *it = record;
+        ++m_version;
+        return true;
+    }
+
+    bool remove(quint64 id)
+    {
+        if (m_records.remove(id) == 0)
+            return false;
+        ++m_version;
+        return true;
+    }
+
+    // Le pointeur retourné est invalidé par toute insertion ultérieure
+    const T *find(quint64 id) const
+    {
+        auto it = m_records.constFind(id);
+        return it == m_records.constEnd() ? nullptr : &it.value();
+    }
+
+    int size() const { return m_records.size(); }
+    const QHash<quint64, T> &records() const { return m_records; }
+
+    // Avant un chargement en masse : une seule allocation pour tout le lot
+    void reserve(int count) { m_records.reserve(count); }
+
+    // Incrémentée à chaque modification : un calcul fait sur une copie sait
+    // si le store a changé depuis
+    quint64 version() const { return m_version; }
+
+private:
+    QHash<quint64, T> m_records;
+    quint64 m_lastId = 0;
+    quint64 m_version = 0;
+};
+
+using EmployeeStore = RecordStore<EmployeeRecord>;
+using OrderStore = RecordStore<OrderRecord>;
+using ProductionStore = RecordStore<ProductionRecord>;
+
+// =======================
+// Index statistiques incrémentaux
+// =======================
+
+// Planning de transitions datées : chaque date porte les identifiants dont
+// l'état change ce jour-là. takeDue() ne visite que les entrées échues.
+class DateSchedule
+{
+public:
+    void schedule(const QDate &date, quint64 id);
+    void cancel(const QDate &date, quint64 id);
+    QVector<quint64> takeDue(const QDate &today);
+    QDate nextDate() const;
+    bool isEmpty() const { return m_entries.isEmpty(); }
+
+private:
+    QMap<QDate, QVector<quint64>> m_entries;
+};
+
+// Répartition des employés par tranche d'âge, tenue à jour à chaque ajout,
+// modification ou suppression. La date à laquelle chaque employé change de
+// tranche (30 ans, puis plus de 50 ans) est planifiée, de sorte qu'un
+// changement de jour ne déplace que les employés concernés.
+class AgeBucketIndex
+{
+public:
+    enum Bucket { Jeunes, Adultes, Seniors, BucketCount };
+
+    AgeBucketIndex();
+
+    void insert(quint64 id, const QDate &dateNaissance);
+    void remove(quint64 id);
+    void advanceTo(const QDate &today);
+
+    int count(Bucket bucket) const { return m_counts[bucket]; }
+    int total() const { return m_entries.size(); }
+
+private:
+    struct Entry
+    {
+        QDate dateNaissance;
+        Bucket bucket;
+        QDate nextTransition;
+    };
+
+    static Bucket bucketFor(const QDate &dateNaissance, const QDate &today);
+    static QDate nextTransitionFor(const QDate &dateNaissance, Bucket bucket);
+
+    QHash<quint64, Entry> m_entries;
+    DateSchedule m_schedule;
+    int m_counts[BucketCount] = {0, 0, 0};
+    QDate m_today;
+};
+
+// Encours (reste à payer) par ancienneté de la commande : 0-30, 31-60, 61-90
+// et plus de 90 jours, au total et par partenaire. Comme pour les tranches
+// d'âge, la date à laquelle chaque commande change de tranche est planifiée,
+// de sorte qu'un changement de jour ne déplace que les commandes concernées.
+class AgingIndex
+{
+public:
+    enum Bucket { Jours0_30, Jours31_60, Jours61_90, Plus90, BucketCount };
+
+    struct Exposure
+    {
+        double montants[BucketCount] = {0.0, 0.0, 0.0, 0.0};
+        int commandes = 0;
+
+        double total() const { return montants[0] + montants[1] + montants[2] + montants[3]; }
+    };
+
+    AgingIndex();
+
+    void insert(const OrderRecord &order);
+    void remove(quint64 id);
+    void advanceTo(const QDate &today);
+
+    const Exposure &global() const { return m_global; }
+    const QMap<QString, Exposure> &parPartenaire() const { return m_partenaires; }
+
+private:
+    struct Entry
+    {
+        QString nom;
+        QDate dateCommande;
+        double reste;
+        Bucket bucket;
+        QDate nextTransition;
+    };
+
+    static Bucket bucketFor(const QDate &dateCommande, const QDate &today);
+    static QDate nextTransitionFor(const QDate &dateCommande, Bucket bucket);
+    void account(const Entry &entry, int sign);
+
+    QHash<quint64, Entry> m_entries;
+    DateSchedule m_schedule;
+    Exposure m_global;
+    QMap<QString, Exposure> m_partenaires;
+    QDate m_today;
+};
+
+// Compteurs de commandes (total, en cours, livrées) appliqués par delta
+// depuis les slots d'enregistrement, de modification et de suppression.
+struct OrderCounters
+{
+    int total = 0;
+    int enCours = 0;
+    int livrees = 0;
+
+    void add(const OrderRecord &order) { apply(order, 1); }
+    void remove(const OrderRecord &order) { apply(order, -1); }
+    double tauxLivraison() const { return total > 0 ? livrees * 100.0 / total : 0.0; }
+
+private:
+    void apply(const OrderRecord &order, int delta);
+};
+
+// Tas binaire max indexé : la position de chaque clé est suivie, ce qui
+// permet de modifier ou de retirer une clé en O(log n). En cas d'égalité,
+// la plus petite clé passe en premier.
+template <typename Key>
+class IndexedMaxHeap
+{
+public:
+    void set(const Key &key, qint64 priority)
+    {
+        auto it = m_positions.constFind(key);
+        if (it == m_positions.constEnd()) {
+            m_nodes.append(Node{key, priority});
+            m_positions.insert(key, m_nodes.size() - 1);
+            siftUp(m_nodes.size() - 1);
+            return;
+        }
+        int i = it.value();
+        m_nodes[i].priority = priority;
+        siftDown(siftUp(i));
+    }
+
+    void remove(const Key &key)
+    {
+        auto it = m_positions.find(key);
+        if (it == m_positions.end())
+            return;
+        int i = it.value();
+        m_positions.erase(it);
+
+        int last = m_nodes.size() - 1;
+        if (i != last) {
+            m_nodes[i] = m_nodes[last];
+            m_positions[m_nodes[i].key] = i;
+        }
+        m_nodes.removeLast();
+        if (i < m_nodes.size())
+            siftDown(siftUp(i));
+    }
+
+    bool isEmpty() const { return m_nodes.isEmpty(); }
+    int size() const { return m_nodes.size(); }
+    Key topKey() const { return m_nodes.first().key; }
+    qint64 topPriority() const { return m_nodes.first().priority; }
+
+private:
+    struct Node
+    {
+        Key key;
+        qint64 priority;
+    };
+
+    static bool before(const Node &a, const Node &b)
+    {
+        return a.priority > b.priority || (a.priority == b.priority && a.key < b.key);
+    }
+
+    void swapNodes(int a, int b)
+    {
+        std::swap(m_nodes[a], m_nodes[b]);
+        m_positions[m_nodes[a].key] = a;
+        m_positions[m_nodes[b].key] = b;
+    }
+
+    int siftUp(int i)
+    {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!before(m_nodes[i], m_nodes[parent]))
+                break;
+            swapNodes(i, parent);
+            i = parent;
+        }
+        return i;
+    }
+
+    void siftDown(int i)
+    {
+        const int n = m_nodes.size();
+        for (;;) {
+            int best = i;
+            int left = 2 * i + 1;
+            int right = left + 1;
+            if (left < n && before(m_nodes[left], m_nodes[best]))
+                best = left;
+            if (right < n && before(m_nodes[right], m_nodes[best]))
+                best = right;
+            if (best == i)
+                return;
+            swapNodes(i, best);
+            i = best;
+        }
+    }
+
+    QVector<Node> m_nodes;
+    QHash<Key, int> m_positions;
+};
+
+// Agrégats de commandes par partenaire (fournisseur ou client), mis à jour
+// par delta. Le partenaire ayant le plus de commandes est lu au sommet d'un
+// tas indexé.
+class PartnerPerformanceIndex
+{
+public:
+    struct Stats
+    {
+        int total = 0;
+        int livrees = 0;
+
+        double tauxLivraison() const { return total > 0 ? livrees * 100.0 / total : 0.0; }
+    };
+
+    void add(const OrderRecord &order) { apply(order, 1); }
+    void remove(const OrderRecord &order) { apply(order, -1); }
+
+    bool contains(const QString &nom) const { return m_stats.contains(nom); }
+    Stats stats(const QString &nom) const { return m_stats.value(nom); }
+    bool isEmpty() const { return m_stats.isEmpty(); }
+    QString meilleur() const { return m_parTotal.topKey(); }
+    int meilleurTotal() const { return int(m_parTotal.topPriority()); }
+
+private:
+    void apply(const OrderRecord &order, int delta);
+
+    QHash<QString, Stats> m_stats;
+    IndexedMaxHeap<QString> m_parTotal;
+};
+
+// Délais de livraison (jours entre commande et livraison) des commandes
+// livrées, par partenaire. Les délais étant des jours entiers, chaque
+// partenaire garde un histogramme par jour : p50/p90 sont exacts et une
+// commande modifiée ou supprimée peut être retirée. Le classement du plus
+// rapide au plus lent est un arbre ordonné mis à jour en O(log n).
+class LeadTimeIndex
+{
+public:
+    struct Summary
+    {
+        int commandes = 0;
+        int p50 = 0;
+        int p90 = 0;
+    };
+
+    struct RankedEntry
+    {
+        QString nom;
+        Summary summary;
+    };
+
+    static int leadTimeDays(const OrderRecord &order);
+
+    void add(const OrderRecord &order) { apply(order, 1); }
+    void remove(const OrderRecord &order) { apply(order, -1); }
+
+    bool contains(const QString &nom) const { return m_sketches.contains(nom); }
+    Summary summary(const QString &nom) const { return m_sketches.value(nom).summary; }
+    bool isEmpty() const { return m_ranking.isEmpty(); }
+    QVector<RankedEntry> ranking(int limit) const;
+
+private:
+    static const int MaxDays = 365;
+
+    struct Sketch
+    {
+        QVector<int> counts;
+        Summary summary;
+
+        int quantile(double q) const;
+    };
+
+    struct RankKey
+    {
+        int p50;
+        int p90;
+        QString nom;
+
+        bool operator<(const RankKey &other) const
+        {
+            if (p50 != other.p50)
+                return p50 < other.p50;
+            if (p90 != other.p90)
+                return p90 < other.p90;
+            return nom < other.nom;
+        }
+    };
+
+    void apply(const OrderRecord &order, int delta);
+
+    QHash<QString, Sketch> m_sketches;
+    QMap<RankKey, Summary> m_ranking;
+};
+
+// Chiffre d'affaires (somme des TTC) et nombre de commandes par client. Chaque
+// critère de classement a son arbre ordonné, mis à jour en O(log n) à chaque
+// commande : le top-K se lit en tête de l'arbre, sans parcourir les clients.
+class ClientRevenueIndex
+{
+public:
+    enum Critere { ChiffreAffaires, NombreCommandes, PanierMoyen };
+
+    struct Stats
+    {
+        int commandes = 0;
+        double chiffreAffaires = 0.0;
+
+        double panierMoyen() const { return commandes > 0 ? chiffreAffaires / commandes : 0.0; }
+    };
+
+    struct RankedEntry
+    {
+        QString nom;
+        Stats stats;
+    };
+
+    void add(const OrderRecord &order) { apply(order, 1); }
+    void remove(const OrderRecord &order) { apply(order, -1); }
+
+    bool isEmpty() const { return m_stats.isEmpty(); }
+    Stats stats(const QString &nom) const { return m_stats.value(nom); }
+    QVector<RankedEntry> top(Critere critere, int k) const;
+
+private:
+    // Valeur décroissante, puis nom croissant
+    struct RankKey
+    {
+        double valeur;
+        QString nom;
+
+        bool operator<(const RankKey &other) const
+        {
+            if (valeur != other.valeur)
+                return valeur > other.valeur;
+            return nom < other.nom;
+        }
+    };
+
+    static double valeurDe(Critere critere, const Stats &stats);
+    void apply(const OrderRecord &order, int sign);
+
+    QHash<QString, Stats> m_stats;
+    QMap<RankKey, Stats> m_classements[3];
+};
+
+// Ventes pré-agrégées à partir des commandes clients, avec les achats
+// fournisseurs du même produit pour la marge : chiffre d'affaires par jour et
+// par produit, encaissements, reste à encaisser et classement des produits.
+// Tenu à jour par delta à chaque commande, le tableau de bord ne parcourt
+// jamais les commandes.
+class SalesEngine
+{
+public:
+    struct ProduitStats
+    {
+        int commandes = 0;
+        int quantite = 0;
+        double ventesHT = 0.0;
+        double ventesTTC = 0.0;
+        int achats = 0;
+        double achatsHT = 0.0;
+
+        double marge() const { return ventesHT - achatsHT; }
+    };
+
+    struct Totaux
+    {
+        int commandes = 0;
+        double ventesHT = 0.0;
+        double ventesTTC = 0.0;
+        double achatsHT = 0.0;
+        double encaisse = 0.0;
+        double resteAEncaisser = 0.0;
+
+        double marge() const { return ventesHT - achatsHT; }
+        double tauxMarge() const { return ventesHT > 0.0 ? marge() * 100.0 / ventesHT : 0.0; }
+    };
+
+    struct Jour
+    {
+        int commandes = 0;
+        double ventesTTC = 0.0;
+    };
+
+    struct RankedProduit
+    {
+        QString produit;
+        ProduitStats stats;
+    };
+
+    void addVente(const OrderRecord &order) { applyVente(order, 1); }
+    void removeVente(const OrderRecord &order) { applyVente(order, -1); }
+    void addAchat(const OrderRecord &order) { applyAchat(order, 1); }
+    void removeAchat(const OrderRecord &order) { applyAchat(order, -1); }
+
+    const Totaux &totaux() const { return m_totaux; }
+    const QMap<QDate, Jour> &ventesParJour() const { return m_jours; }
+    QVector<RankedProduit> topProduits(int k) const;
+
+private:
+    // Ventes TTC décroissantes, puis produit croissant
+    struct RankKey
+    {
+        double ventesTTC;
+        QString produit;
+
+        bool operator<(const RankKey &other) const
+        {
+            if (ventesTTC != other.ventesTTC)
+                return ventesTTC > other.ventesTTC;
+            return produit < other.produit;
+        }
+    };
+
+    static QString produitDe(const OrderRecord &order);
+    void applyVente(const OrderRecord &order, int sign);
+    void applyAchat(const OrderRecord &order, int sign);
+    void modifierProduit(const QString &produit, const std::function<void(ProduitStats &)> &modification);
+
+    Totaux m_totaux;
+    QMap<QDate, Jour> m_jours;
+    QHash<QString, ProduitStats> m_produits;
+    QMap<RankKey, ProduitStats> m_classement;
+};
+
+// Cube pré-agrégé des productions : type produit × mois × qualité. Chaque
+// production alimente les 8 cellules obtenues en remplaçant une ou plusieurs
+// dimensions par « toutes » ; un drill-down ou un roll-up n'est donc qu'une
+// recherche dans la table de hachage, sans parcourir les productions.
+class ProductionCube
+{
+public:
+    enum Dimension { DimType, DimMois, DimQualite };
+
+    struct Measures
+    {
+        int count = 0;
+        double kg = 0.0;
+        double litres = 0.0;
+        double rendementTotal = 0.0;
+        int rendementCount = 0;
+
+        double rendementMoyen() const { return rendementCount > 0 ? rendementTotal / rendementCount : 0.0; }
+    };
+
+    // Coordonnées d'une cellule : type/qualité vides ou mois à 0 = toutes
+    struct Slice
+    {
+        QString type;
+        int mois = 0;   // AAAAMM
+        QString qualite;
+    };
+
+    struct Member
+    {
+        Slice slice;
+        QString libelle;
+        Measures mesures;
+    };
+
+    static int moisCle(const QDate &date) { return date.isValid() ? date.year() * 100 + date.month() : 0; }
+    static QString moisLibelle(int mois);
+    static QString qualiteDe(const ProductionRecord &record);
+
+    void add(const ProductionRecord &record) { apply(record, 1); }
+    void remove(const ProductionRecord &record) { apply(record, -1); }
+
+    Measures cell(const Slice &slice) const { return m_cells.value(cellKey(slice)); }
+    QVector<Member> drillDown(const Slice &slice, Dimension dimension) const;
+
+private:
+    static QString cellKey(const Slice &slice);
+    void apply(const ProductionRecord &record, int sign);
+
+    QHash<QString, Measures> m_cells;
+    // Membres de chaque dimension (avec nombre de productions) pour le drill-down
+    QMap<QString, int> m_types;
+    QMap<int, int> m_mois;
+    QMap<QString, int> m_qualites;
+};
+
+// Volumes de production (KG de matière, L produits) agrégés par jour, semaine
+// et mois. Chaque granularité garde un tableau de seaux de largeur fixe à
+// partir d'une date d'origine : une production ajoute ou retire un delta dans
+// trois seaux. rebuild() repart des colonnes brutes triées par date, les seaux
+// étant alors des plages contiguës sommées par un noyau vectoriel.
+class ProductionTimeSeries
+{
+public:
+    enum Granularity { Jour, Semaine, Mois };
+
+    struct Point
+    {
+        QDate debut;
+        double kg = 0.0;
+        double litres = 0.0;
+    };
+
+    void add(const ProductionRecord &record) { apply(record.dateProduction, record.quantiteMatiere, record.quantiteProduite); }
+    void remove(const ProductionRecord &record) { apply(record.dateProduction, -record.quantiteMatiere, -record.quantiteProduite); }
+    void rebuild(const ProductionStore &store);
+
+    QVector<Point> series(Granularity granularity) const;
+
+private:
+    struct Buckets
+    {
+        QDate origin;
+        QVector<double> kg;
+        QVector<double> litres;
+    };
+
+    static QDate bucketStart(Granularity granularity, const QDate &date);
+    static int bucketOffset(Granularity granularity, const QDate &origin, const QDate &date);
+    static QDate bucketDate(Granularity granularity, const QDate &origin, int index);
+
+    void apply(const QDate &date, double kg, double litres);
+    void rollUpFromDays(Granularity granularity);
+
+    Buckets m_buckets[3];
+};
+
+// Analyse des rendements (KG/L) des productions. Moyenne et écart-type par
+// type et par mois sont tenus en un seul passage (Welford, réversible pour
+// les suppressions). Les rendements étant saisis au centième, chaque type
+// garde aussi la répartition exacte de ses valeurs : médiane et MAD s'en
+// déduisent sans tri, et les lots atypiques sont ceux des deux extrémités
+// dont le z-score robuste dépasse SeuilZ.
+class YieldAnalytics
+{
+public:
+    struct Moments
+    {
+        int n = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        void add(double x);
+        void remove(double x);
+        double stddev() const;
+    };
+
+    struct GroupStats
+    {
+        QString type;
+        int mois = 0;   // AAAAMM, 0 = tous les mois
+        Moments moments;
+    };
+
+    struct Outlier
+    {
+        quint64 id = 0;
+        QString type;
+        double rendement = 0.0;
+        double zScore = 0.0;
+    };
+
+    static constexpr double SeuilZ = 3.5;
+    static constexpr double LargeurClasse = 0.5;
+    static const int NombreClasses = 30;   // la dernière classe regroupe le dépassement
+
+    void add(const ProductionRecord &record) { apply(record, 1); }
+    void remove(const ProductionRecord &record) { apply(record, -1); }
+
+    const QVector<int> &histogram() const { return m_histogram; }
+    QVector<GroupStats> groups() const;
+    QVector<Outlier> outliers() const;
+
+private:
+    struct Distribution
+    {
+        QMap<int, QVector<quint64>> valeurs;   // rendement en centièmes -> lots
+        Moments moments;
+        int medianeCenti = 0;
+        int madCenti = 0;
+    };
+
+    static int classeDe(double rendement);
+    static void refreshRobust(Distribution &distribution);
+    void apply(const ProductionRecord &record, int sign);
+
+    QVector<int> m_histogram = QVector<int>(NombreClasses, 0);
+    QMap<QString, Distribution> m_types;
+    QMap<QString, QMap<int, Moments>> m_groupes;
+};
+
+// =======================
+// Modèles de tables virtuels
+// =======================
+// La vue ne stocke aucune cellule : le modèle ne garde que l'ordre
+// d'affichage des identifiants et formate chaque cellule à la demande depuis
+// le store. Une table d'un million de lignes ne coûte donc que les lignes
+// visibles au rendu.
+
+template <typename T>
+class RecordTableModel : public QAbstractTableModel
+{
+public:
+    struct Column
+    {
+        QString titre;
+        std::function<QString(const T &)> texte;
+    };
+
+    RecordTableModel(const RecordStore<T> &store, QVector<Column> columns, QObject *parent = nullptr)
+        : QAbstractTableModel(parent), m_store(store), m_columns(std::move(columns))
+    {
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_ids.size();
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_columns.size();
+    }
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
+    {
+        if (role != Qt::DisplayRole || !index.isValid())
+            return QVariant();
+        return text(index.row(), index.column());
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+    {
+        if (role == Qt::DisplayRole && orientation == Qt::Horizontal && section < m_columns.size())
+            return m_columns[section].titre;
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    QString text(int row, int column) const
+    {
+        const T *record = m_store.find(idAt(row));
+        return record ? m_columns[column].texte(*record) : QString();
+    }
+
+    quint64 idAt(int row) const { return row >= 0 && row < m_ids.size() ? m_ids[row] : 0; }
+    // Ligne courante : position enregistrée moins les retraits placés avant
+    // elle depuis la dernière renumérotation
+    int rowOf(quint64 id) const
+    {
+        const auto it = m_rows.constFind(id);
+        if (it == m_rows.constEnd())
+            return -1;
+        return it.value() - int(std::lower_bound(m_retraits.cbegin(), m_retraits.cend(), it.value())
+                                - m_retraits.cbegin());
+    }
+
+    // Ordre d'affichage et formatage des colonnes : une copie suffit pour
+    // reproduire la table hors du thread graphique
+    const QVector<quint64> &ids() const { return m_ids; }
+    const QVector<Column> &columns() const { return m_columns; }
+
+    // Notifications du store : une seule ligne insérée, rafraîchie ou retirée
+    void recordInserted(quint64 id)
+    {
+        if (m_batchDepth > 0) {
+            m_pending.append(id);
+            return;
+        }
+        const int row = m_ids.size();
+        beginInsertRows(QModelIndex(), row, row);
+        m_ids.append(id);
+        m_rows.insert(id, row + m_retraits.size());
+        endInsertRows();
+    }
+
+    void recordUpdated(quint64 id)
+    {
+        const int row = rowOf(id);
+        if (row < 0)
+            return;
+        if (m_batchDepth > 0) {
+            m_updatedFirst = qMin(m_updatedFirst, row);
+            m_updatedLast = qMax(m_updatedLast, row);
+            return;
+        }
+        emit dataChanged(index(row, 0), index(row, m_columns.size() - 1));
+    }
+
+    void recordRemoved(quint64 id)
+    {
+        if (m_batchDepth > 0) {
+            removeInBatch(id);
+            return;
+        }
+        const int row = rowOf(id);
+        if (row < 0)
+            return;
+        beginRemoveRows(QModelIndex(), row, row);
+        m_ids.remove(row);
+        // Les lignes suivantes ne sont pas renumérotées : la position retirée
+        // est notée, rowOf() en tient compte
+        const int position = m_rows.take(id);
+        m_retraits.insert(std::lower_bound(m_retraits.begin(), m_retraits.end(), position), position);
+        if (m_retraits.size() > SeuilRenumerotation)
+            renumber();
+        endRemoveRows();
+    }
+
+    // Lot de modifications : aucune notification ligne par ligne. À la fin
+    // du lot, les ajouts sont publiés en une seule insertion de plage et les
+    // rafraîchissements en un seul dataChanged ; une suppression fait basculer
+    // le lot en une réinitialisation unique du modèle.
+    void beginBatch()
+    {
+        if (m_batchDepth++ == 0) {
+            m_updatedFirst = INT_MAX;
+            m_updatedLast = -1;
+        }
+    }
+
+    void endBatch()
+    {
+        if (m_batchDepth == 0 || --m_batchDepth > 0)
+            return;
+
+        if (m_resetting) {
+            m_ids.erase(std::remove_if(m_ids.begin(), m_ids.end(),
+                                       [this](quint64 id) { return m_removed.contains(id); }),
+                        m_ids.end());
+            m_ids += m_pending;
+            m_pending.clear();
+            m_removed.clear();
+            m_rows.clear();
+            renumber();
+            m_resetting = false;
+            endResetModel();
+            return;
+        }
+
+        if (m_updatedFirst <= m_updatedLast)
+            emit dataChanged(index(m_updatedFirst, 0), index(m_updatedLast, m_columns.size() - 1));
+
+        if (!m_pending.isEmpty()) {
+            const int first = m_ids.size();
+            beginInsertRows(QModelIndex(), first, first + m_pending.size() - 1);
+            m_ids += m_pending;
+            m_rows.reserve(m_ids.size());
+            for (int row = first; row < m_ids.size(); ++row)
+                m_rows.insert(m_ids[row], row + m_retraits.size());
+            m_pending.clear();
+            endInsertRows();
+        }
+    }
+
+    // Tri stable sur les enregistrements ; la sélection suit ses lignes
+    template <typename LessThan>
+    void sortRecords(LessThan lessThan)
+    {
+        emit layoutAboutToBeChanged();
+
+        const QModelIndexList avant = persistentIndexList();
+        QVector<quint64> suivis;
+        suivis.reserve(avant.size());
+        for (const QModelIndex &persistant : avant)
+            suivis.append(idAt(persistant.row()));
+
+        QVector<QPair<const T *, quint64>> lignes;
+        lignes.reserve(m_ids.size());
+        for (quint64 id : std::as_const(m_ids))
+            lignes.append(qMakePair(m_store.find(id), id));
+        std::stable_sort(lignes.begin(), lignes.end(),
+                         [&lessThan](const QPair<const T *, quint64> &a, const QPair<const T *, quint64> &b) {
+                             return lessThan(*a.first, *b.first);
+                         });
+        for (int row = 0; row < lignes.size(); ++row)
+            m_ids[row] = lignes[row].second;
+        renumber();
+
+        QModelIndexList apres;
+        apres.reserve(avant.size());
+        for (int i = 0; i < avant.size(); ++i)
+            apres.append(index(rowOf(suivis[i]), avant[i].column()));
+        changePersistentIndexList(avant, apres);
+
+        emit layoutChanged();
+    }
+
+private:
+    // Au-delà de ce nombre de retraits, les positions sont réécrites en une
+    // passe : un retrait coûte O(log k) plus n / SeuilRenumerotation amorti
+    static constexpr int SeuilRenumerotation = 1024;
+
+    void renumber()
+    {
+        m_retraits.clear();
+        m_rows.reserve(m_ids.size());
+        for (int row = 0; row < m_ids.size(); ++row)
+            m_rows[m_ids[row]] = row;
+    }
+
+    void removeInBatch(quint64 id)
+    {
+        const int pending = m_pending.indexOf(id);
+        if (pending >= 0) {
+            m_pending.remove(pending);
+            return;
+        }
+        if (rowOf(id) < 0)
+            return;
+        if (!m_resetting) {
+            beginResetModel();
+            m_resetting = true;
+        }
+        // Compactage différé à endBatch() : un retrait reste en O(1)
+        m_removed.insert(id);
+        m_rows.remove(id);
+    }
+
+    const RecordStore<T> &m_store;
+    QVector<Column> m_columns;
+    QVector<quint64> m_ids;        // ordre d'affichage
+    QHash<quint64, int> m_rows;    // identifiant -> position à la dernière renumérotation
+    QVector<int> m_retraits;       // positions retirées depuis, croissantes
+
+    // Lot en cours
+    int m_batchDepth = 0;
+    bool m_resetting = false;
+    QVector<quint64> m_pending;    // ajouts pas encore publiés
+    QSet<quint64> m_removed;       // retraits à compacter
+    int m_updatedFirst = INT_MAX;
+    int m_updatedLast = -1;
+};
+
+using EmployeeTableModel = RecordTableModel<EmployeeRecord>;
+using OrderTableModel = RecordTableModel<OrderRecord>;
+using ProductionTableModel = RecordTableModel<ProductionRecord>;
+
+// Performance par partenaire : une ligne par nom, les valeurs sont lues dans
+// les index au rendu
+class PerformanceTableModel : public QAbstractTableModel
+{
+public:
+    PerformanceTableModel(const QString &titreNom, const PartnerPerformanceIndex &index,
+                          const LeadTimeIndex &delais, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Ajoute, rafraîchit ou retire la ligne du partenaire selon l'index
+    void partnerChanged(const QString &nom);
+
+    // Lot de modifications publié en une seule réinitialisation
+    void beginBatch();
+    void endBatch();
+
+private:
+    QString m_titreNom;
+    const PartnerPerformanceIndex &m_index;
+    const LeadTimeIndex &m_delais;
+    QVector<QString> m_noms;        // triés : l'ordre alphabétique est l'ordre d'affichage
+    int m_batchDepth = 0;
+};
+
+// Filtre incrémental entre un modèle de table et sa vue. La visibilité de
+// chaque ligne source est tenue dans un bitmap, les lignes visibles dans un
+// tableau compact trié. Un changement de filtre ou de données n'émet que les
+// plages de lignes insérées ou retirées ; au-delà de SeuilPlages plages, une
+// seule réinitialisation coûte moins cher à la vue.
+class FilterProxyModel : public QAbstractProxyModel
+{
+public:
+    using Predicate = std::function<bool(int sourceRow)>;
+
+    explicit FilterProxyModel(QObject *parent = nullptr);
+
+    void setSourceModel(QAbstractItemModel *source) override;
+
+    // Remplace le filtre ; un prédicat vide laisse tout passer
+    void setFilter(Predicate predicate);
+
+    int sourceRow(int row) const { return row >= 0 && row < m_rows.size() ? m_rows[row] : -1; }
+
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    static constexpr int SeuilPlages = 32;
+
+    bool accepts(int sourceRow) const { return !m_predicate || m_predicate(sourceRow); }
+    int proxyRowOf(int sourceRow) const;
+    void rebuildRows();
+    void applyVisibility(int from, const QBitArray &next);
+
+    void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void sourceRowsRemoved(const QModelIndex &parent, int first, int last);
+    void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void sourceLayoutAboutToBeChanged();
+    void sourceLayoutChanged();
+    void sourceAboutToBeReset();
+    void sourceReset();
+
+    Predicate m_predicate;
+    QBitArray m_visible;            // visibilité par ligne source
+    QVector<int> m_rows;            // lignes source visibles, croissantes
+    bool m_removing = false;
+    QModelIndexList m_layoutProxies;
+    QList<QPersistentModelIndex> m_layoutSources;
+    QList<QMetaObject::Connection> m_connections;
+};
+
+// =======================
+// Thème OLIVERAQ
+// =======================
+// Couleurs et rôles visuels définis une seule fois. Un widget s'inscrit par
+// rôle (OliveraqTheme::apply) : police, palette et marges sont fixées
+// directement, fonds, cadres et boutons sont dessinés par OliveraqStyle.
+// Aucune feuille de style n'est analysée ni re-polie.
+class OliveraqTheme
+{
+public:
+    enum Couleur : QRgb {
+        OliveFonce     = 0x556b2f,
+        Olive          = 0x6b8e23,
+        OliveVif       = 0x7a9e2d,
+        OliveNuit      = 0x4a5a26,
+        Olivier        = 0x808000,
+        OliveGris      = 0x9aab6b,
+        CremeOlive     = 0xfafff0,
+        CremePresse    = 0xf0f5e0,
+        Sauge          = 0x7a8f4e,
+        SaugeClair     = 0x9bb35d,
+        Mousse         = 0x5f6f3e,
+        FondApplication = 0xf4f7f1,
+        Blanc          = 0xffffff,
+        Encre          = 0x2c3e50,
+        BordureChamp   = 0xd5d5d5,
+        BordureClaire  = 0xe0e0e0,
+        Nuage          = 0xecf0f1,
+        EnTeteClair    = 0xf5f7fa,
+        FondEnonce     = 0xf9f9f9,
+        LectureSeule   = 0xf0f0f0,
+        VertPale       = 0xe8f5e9,
+        VertSucces     = 0x2e7d32,
+        VertFilet      = 0x4caf50,
+        RougePale      = 0xffebee,
+        RougeErreur    = 0xc62828,
+        RougeFilet     = 0xf44336,
+        StockBouton    = 0x5c7a3a,
+        StockSurvol    = 0x6b8a4a,
+        StockFonce     = 0x4a6a2a,
+        StockEncre     = 0x1a3009,
+        Beige          = 0xf5f5dc,
+        Ciel           = 0x87ceeb,
+        GrilleStock    = 0xd0d0d0
+    };
+
+    enum Role {
+        Aucun,
+        // Surfaces
+        PageDegradee,       // fond dégradé des pages menu, mot de passe et quiz
+        PageStock,          // fond beige ; habille aussi les widgets sans rôle de la page
+        Bandeau,            // en-tête dégradé avec filet bas
+        Carte,              // conteneur blanc arrondi
+        PanneauBlanc,
+        PanneauLateral,
+        // Textes
+        TitreCarte,
+        SousTitreCarte,
+        LibelleChamp,
+        TitreBandeau,
+        TitreMenu,
+        Titre,
+        TitreSection,
+        SousSection,
+        LibelleSection,
+        Annotation,
+        TexteStock,
+        Indicateur,
+        Progression,
+        Enonce,
+        Retour,
+        RetourBilan,
+        RetourSucces,
+        RetourErreur,
+        // Boutons ; un QPushButton sans rôle est dessiné en BoutonDefaut
+        BoutonDefaut,
+        BoutonPrincipal,
+        BoutonSecondaire,
+        BoutonMenu,
+        BoutonLateral,
+        BoutonStock,
+        // Saisie
+        Champ,
+        ChampStock,
+        Option,
+        // Tables (le rôle est reporté sur les en-têtes)
+        Tableau,
+        TableauStock
+    };
+
+    static void apply(QWidget *widget, Role role);
+    static Role roleOf(const QWidget *widget);
+    static QPalette palette();
+};
+
+class OliveraqStyle : public QProxyStyle
+{
+public:
+    OliveraqStyle();
+
+    using QProxyStyle::polish;
+    void polish(QWidget *widget) override;
+
+    void drawPrimitive(PrimitiveElement element, const QStyleOption *option,
+                       QPainter *painter, const QWidget *widget = nullptr) const override;
+    void drawControl(ControlElement element, const QStyleOption *option,
+                     QPainter *painter, const QWidget *widget = nullptr) const override;
+    void drawComplexControl(ComplexControl control, const QStyleOptionComplex *option,
+                            QPainter *painter, const QWidget *widget = nullptr) const override;
+    QSize sizeFromContents(ContentsType type, const QStyleOption *option,
+                           const QSize &size, const QWidget *widget = nullptr) const override;
+    int pixelMetric(PixelMetric metric, const QStyleOption *option = nullptr,
+                    const QWidget *widget = nullptr) const override;
+    int styleHint(StyleHint hint, const QStyleOption *option = nullptr,
+                  const QWidget *widget = nullptr, QStyleHintReturn *returnData = nullptr) const override;
+
+private:
+    void drawPanneauChamp(OliveraqTheme::Role role, const QStyleOption *option, QPainter *painter) const;
+    void drawBouton(OliveraqTheme::Role role, const QStyleOption *option, QPainter *painter) const;
+};
 
 // Pie chart widget (inlined here so we only need main window files)
 class PieChartWidget : public QWidget
@@ -30,14 +1221,244 @@ class PieChartWidget : public QWidget
 public:
     explicit PieChartWidget(QWidget *parent = nullptr);
     void setData(const QMap<QString, int> &data, int total);
+    void setData(QMap<QString, int> &&data, int total);
 
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
 
 private:
+    // Part visible après regroupement, géométrie de légende précalculée
+    struct Slice
+    {
+        QString label;
+        int value = 0;
+        double startAngle = 0.0;
+        double spanAngle = 0.0;
+        QColor color;
+        QRect legendRect;
+        QString legendText;
+    };
+
+    // Les parts sous ce pourcentage sont regroupées dans « Autres »
+    static constexpr double SeuilAutresPourcent = 3.0;
+
+    // Le rendu est mis en cache dans un pixmap à la résolution de l'écran,
+    // invalidé par setData() ou un redimensionnement ; la mise en page
+    // (regroupement, légende, angles) est refaite à ce moment-là
+    void layoutChart();
+    void renderChart(QPainter &painter) const;
+    void invalidateCache();
+    int sliceAt(const QPoint &pos) const;
+
     QMap<QString, int> m_data;
     int m_total;
     QList<QColor> m_colors;
+    QPixmap m_cache;
+    QFont m_legendFont;
+    QFont m_totalFont;
+    QRect m_pieRect;
+    QVector<Slice> m_slices;
+    QVector<double> m_sliceEnds;   // angles de fin cumulés, pour le hit-test
+    QStringList m_autres;
+};
+
+// Line chart widget : une courbe par série, abscisses partagées. Chaque
+// série est réduite à environ un point par pixel (Largest-Triangle-Three-
+// Buckets) ; la réduction est mise en cache par niveau de zoom (puissance de
+// 2), un déplacement ne fait donc que découper le cache. Molette : zoom
+// autour du curseur, glisser : déplacement, double-clic : vue complète.
+class LineChartWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    struct Series
+    {
+        QString nom;
+        QColor couleur;
+        QVector<double> valeurs;
+    };
+
+    explicit LineChartWidget(QWidget *parent = nullptr);
+    void setData(const QStringList &labels, const QVector<Series> &series);
+    void setEmptyText(const QString &texte);
+
+    static QVector<QPointF> lttb(const QVector<double> &valeurs, int seuil);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    QRect plotRect() const;
+    int pointCount() const;
+    void clampWindow();
+    const QVector<QVector<QPointF>> &decimated(int niveau);
+
+    QStringList m_labels;
+    QVector<Series> m_series;
+    QString m_emptyText = "Aucune production enregistrée.";
+
+    // Fenêtre visible, en indices de points
+    double m_debut = 0.0;
+    double m_fin = 0.0;
+
+    QHash<int, QVector<QVector<QPointF>>> m_cache;   // niveau -> série réduite
+    int m_cacheWidth = 0;
+    bool m_dragging = false;
+    double m_dragOrigin = 0.0;
+    double m_dragDebut = 0.0;
+};
+
+// Histogram widget : une barre par classe
+class HistogramWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit HistogramWidget(QWidget *parent = nullptr);
+    void setData(const QStringList &labels, const QVector<int> &counts);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    QStringList m_labels;
+    QVector<int> m_counts;
+};
+
+// Copie figée des stores pour les calculs en arrière-plan. Les QHash étant
+// partagés implicitement, la copie est immédiate ; une modification ultérieure
+// du store détache celui-ci sans toucher à la copie.
+struct StoreSnapshot
+{
+    EmployeeStore employes;
+    OrderStore fournisseurs;
+    OrderStore clients;
+    ProductionStore productions;
+};
+
+// Exécuteur des calculs statistiques lourds : chaque tâche est identifiée par
+// une clé, une nouvelle soumission annule la précédente de même clé. La tâche
+// calcule sur un thread du pool et renvoie une fonction de publication, remise
+// au thread graphique par un signal en file d'attente.
+class AnalyticsExecutor : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Publisher = std::function<void()>;
+    using Job = std::function<Publisher(const StoreSnapshot &snapshot, const std::atomic_bool &cancelled)>;
+
+    explicit AnalyticsExecutor(QObject *parent = nullptr);
+    ~AnalyticsExecutor() override;
+
+    void submit(const QString &key, const StoreSnapshot &snapshot, const Job &job);
+    void cancelAll();
+
+signals:
+    void jobFinished(const QString &key, quint64 generation, const AnalyticsExecutor::Publisher &publisher);
+
+private slots:
+    void deliver(const QString &key, quint64 generation, const AnalyticsExecutor::Publisher &publisher);
+
+private:
+    struct Pending
+    {
+        quint64 generation = 0;
+        std::shared_ptr<std::atomic_bool> cancelled;
+    };
+
+    QThreadPool m_pool;
+    QHash<QString, Pending> m_pending;
+    quint64 m_nextGeneration = 0;
+};
+
+Q_DECLARE_METATYPE(AnalyticsExecutor::Publisher)
+
+// File des rapports PDF : chaque document est rendu sur un thread du pool à
+// partir de données copiées au moment de la demande. L'avancement et la fin
+// de chaque rapport sont remis au thread graphique par des signaux en file
+// d'attente ; un rapport annulé ne laisse pas de fichier.
+class ReportQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Outcome { Generated, Cancelled, Failed };
+
+    // Côté rendu : point de contrôle d'annulation et avancement en pourcentage
+    class Control
+    {
+    public:
+        Control(ReportQueue *queue, int id, const std::shared_ptr<std::atomic_bool> &cancelled);
+
+        bool cancelled() const { return *m_cancelled; }
+        void setProgress(int percent);
+
+        // Bilan affiché à la fin du rapport (débit d'un lot, par exemple)
+        void setSummary(const QString &resume) { m_resume = resume; }
+        QString summary() const { return m_resume; }
+
+    private:
+        ReportQueue *m_queue;
+        int m_id;
+        std::shared_ptr<std::atomic_bool> m_cancelled;
+        int m_percent = -1;
+        QString m_resume;
+    };
+
+    // Le rendu reçoit une imprimante PDF A4 haute résolution déjà dirigée
+    // vers le fichier ; il renvoie false en cas d'échec ou d'annulation
+    using Job = std::function<bool(QPrinter &printer, Control &control)>;
+
+    // Rendu qui écrit lui-même ses fichiers (lots de factures) ; il retire
+    // ce qu'il a écrit s'il est annulé
+    using Task = std::function<bool(Control &control)>;
+
+    explicit ReportQueue(QObject *parent = nullptr);
+    ~ReportQueue() override;
+
+    int submit(const QString &titre, const QString &fileName, const Job &job);
+    int submitTask(const QString &titre, const QString &path, const Task &task);
+    void cancel(int id);
+
+    // Plus ancien rapport non terminé, 0 si la file est vide
+    int current() const { return m_entries.isEmpty() ? 0 : m_entries.firstKey(); }
+    int count() const { return m_entries.size(); }
+    QString title(int id) const { return m_entries.value(id).titre; }
+    int progress(int id) const { return m_entries.value(id).percent; }
+
+signals:
+    void changed();
+    void reportFinished(const QString &path, ReportQueue::Outcome outcome, const QString &resume);
+
+    // Émis depuis le thread du pool
+    void progressed(int id, int percent);
+    void finished(int id, int outcome, const QString &resume);
+
+private slots:
+    void onProgressed(int id, int percent);
+    void onFinished(int id, int outcome, const QString &resume);
+
+private:
+    struct Entry
+    {
+        QString titre;
+        QString path;
+        int percent = 0;
+        std::shared_ptr<std::atomic_bool> cancelled;
+    };
+
+    QThreadPool m_pool;
+    QMap<int, Entry> m_entries;
+    int m_nextId = 0;
 };
 
 class MainWindow : public QMainWindow
@@ -48,6 +1469,13 @@ public:
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    // Import en masse (fichier, rejeu de journal) : une seule notification
+    // par table et des statistiques recalculées une fois à la fin du lot
+    void importerEmployes(const QVector<EmployeeRecord> &records);
+    void importerCommandesFournisseurs(const QVector<OrderRecord> &records);
+    void importerCommandesClients(const QVector<OrderRecord> &records);
+    void importerProductions(const QVector<ProductionRecord> &records);
+
 private slots:
     // Navigation principales
     void openGestionEmployes();
@@ -57,6 +1485,7 @@ private slots:
     void openGestionClients();
     void openGestionStocks();
     void openQuiz();
+    void openGestionVentes();
 
     // Mot de passe
     void changePassword();
@@ -84,6 +1513,7 @@ private slots:
     void searchFournisseur();
     void sortCommandesParNom();
     void exportFacturePDF();
+    void exportFacturesLotFournisseurs();
     void updateFournisseurStatistics();
     void updatePerformanceMetrics();
     void calculatePrixTTC();
@@ -100,6 +1530,7 @@ private slots:
     void searchClient();
     void sortCommandesClients();
     void exportFactureClientPDF();
+    void exportFacturesLotClients();
     void updateClientStatistics();
     void updateClientPerformance();
     void calculatePrixTTCClient();
@@ -122,34 +1553,130 @@ private slots:
     void on_comboRechercheTypeStock_currentIndexChanged(int index);
     void on_comboTriStock_currentIndexChanged(int index);
     void on_comboTypeProduitStock_currentIndexChanged(int index);
+    void on_comboCubeAxeStock_currentIndexChanged(int index);
+    void on_tableCubeStock_cellDoubleClicked(int row, int column);
+    void on_btnCubeRemonterStock_clicked();
+    void on_comboGranulariteStock_currentIndexChanged(int index);
 
 private:
     void setupUI();
     void setupStyle();
-    void reindexIds();
+    void setupModels();
+    void setupRapports();
+
+    // Construction paresseuse : seules les pages login et menu sont créées
+    // au démarrage, les autres à la première navigation
+    enum class Page { MotDePasse, Employes, Fournisseurs, Clients, Stocks, Ventes, Quiz };
+    QWidget *ensurePage(Page page);
+    void prewarmNextPage();
+    void buildPageChangePassword();
+    void buildPageEmployes();
+    void buildPageFournisseurs();
+    void buildPageClients();
+    void buildPageStocks();
+    void buildPageVentes();
+    void buildPageQuiz();
     void updateStatistics();
     void initializeQuiz();
     void showCurrentQuizQuestion();
+
+    // Propagation des modifications de commandes vers les index incrémentaux
+    void applyFournisseurDelta(const OrderRecord *before, const OrderRecord *after);
+    void applyClientDelta(const OrderRecord *before, const OrderRecord *after);
+    void updateClassementDelais();
+    void updateClassementClients();
+    void updateEncours(QTableWidget *table, AgingIndex &index);
+    void appliquerTransitionsDatees();
+    void rafraichirStatistiques();
+    void beginBulkLoad();
+    void endBulkLoad();
+    void importerCommandes(OrderStore &store, DateSchedule &livraisons, OrderTableModel *modele,
+                           void (MainWindow::*applyDelta)(const OrderRecord *, const OrderRecord *),
+                           const QVector<OrderRecord> &records);
+    int livrerCommandesEchues(OrderStore &store, DateSchedule &livraisons,
+                              OrderTableModel *modele,
+                              void (MainWindow::*applyDelta)(const OrderRecord *, const OrderRecord *),
+                              const QDate &today);
+    void applyProductionDelta(const ProductionRecord *before, const ProductionRecord *after);
+    void updateCubeStock();
+    void updateCourbesStock();
+    void updateRendementsStock();
+    StoreSnapshot snapshotStores() const;
+    void rebuildProductionAnalyticsAsync();
+    void updateTableauVentes();
     
     // Gestion de Stock - méthodes privées
     void clearFieldsStock();
-    void updateTableRowStock(int row);
     void trierTableauStock();
     void filtrerParTypeStock();
     void genererStatistiquesStock();
     void exporterPDFStock();
     QDate parseDateFromStringStock(const QString &dateStr);
 
+    // Données (stores indexés par identifiant stable)
+    EmployeeStore employeeStore;
+    OrderStore fournisseurStore;
+    OrderStore clientStore;
+    ProductionStore productionStore;
+
+    // Modèles des tables, créés avec la fenêtre : les pages construites plus
+    // tard ne font que s'y attacher
+    EmployeeTableModel *modeleEmployes = nullptr;
+    OrderTableModel *modeleFournisseurs = nullptr;
+    OrderTableModel *modeleClients = nullptr;
+    ProductionTableModel *modeleProductions = nullptr;
+    PerformanceTableModel *modelePerformanceFournisseurs = nullptr;
+    PerformanceTableModel *modelePerformanceClients = nullptr;
+    FilterProxyModel *filtreEmployes = nullptr;
+    FilterProxyModel *filtreFournisseurs = nullptr;
+    FilterProxyModel *filtreClients = nullptr;
+    FilterProxyModel *filtreProductions = nullptr;
+    int bulkLoadDepth = 0;
+
+    // Statistiques incrémentales
+    AgeBucketIndex ageBuckets;
+    OrderCounters fournisseurCounters;
+    OrderCounters clientCounters;
+    PartnerPerformanceIndex fournisseurPerformance;
+    PartnerPerformanceIndex clientPerformance;
+    LeadTimeIndex fournisseurDelais;
+    LeadTimeIndex clientDelais;
+    ClientRevenueIndex clientRevenus;
+    AgingIndex fournisseurEncours;
+    AgingIndex clientEncours;
+    SalesEngine ventes;
+
+    // Moteur de statuts : commandes « En cours » planifiées à leur date de livraison
+    DateSchedule livraisonsFournisseurs;
+    DateSchedule livraisonsClients;
+    QTimer *timerStatuts = nullptr;
+    ProductionCube productionCube;
+    ProductionTimeSeries productionSeries;
+    YieldAnalytics rendementAnalytics;
+    AnalyticsExecutor *analyticsExecutor;
+
+    // Rapports PDF en arrière-plan, suivis dans la barre d'état
+    ReportQueue *reportQueue = nullptr;
+    QWidget *panneauRapports = nullptr;
+    QLabel *labelRapport = nullptr;
+    QProgressBar *progressRapport = nullptr;
+    QPushButton *btnAnnulerRapport = nullptr;
+    void afficherRapports();
+    void rapportTermine(const QString &path, ReportQueue::Outcome outcome, const QString &resume);
+    void exporterFacturesLot(const QString &titre, const QString &libelle, const OrderStore &store,
+                             const OrderTableModel *modele);
+
     // Navigation générale
     QStackedWidget *mainStack;
     QWidget *pageLogin;
     QWidget *pageMenu;
-    QWidget *pageChangePassword;
-    QWidget *pageEmployes;
-    QWidget *pageFournisseurs;
-    QWidget *pageClients;
-    QWidget *pageStocks;
-    QWidget *pageQuiz;
+    QWidget *pageChangePassword = nullptr;
+    QWidget *pageEmployes = nullptr;
+    QWidget *pageFournisseurs = nullptr;
+    QWidget *pageClients = nullptr;
+    QWidget *pageStocks = nullptr;
+    QWidget *pageVentes = nullptr;
+    QWidget *pageQuiz = nullptr;
 
     // Login
     QLineEdit *editUser;
@@ -176,7 +1703,7 @@ private:
     // Employés - liste
     QLineEdit *editSearch;
     QComboBox *comboSort;
-    QTableWidget *tableEmployes;
+    QTableView *tableEmployes;
     QPushButton *btnAjouter;
     QPushButton *btnModifier;
     QPushButton *btnSupprimer;
@@ -211,7 +1738,7 @@ private:
     QWidget *pageDetailsFournisseurs;
 
     // Fournisseurs - liste
-    QTableWidget *tableFournisseurs;
+    QTableView *tableFournisseurs;
     QPushButton *btnModifierFournisseur;
     QPushButton *btnSupprimerFournisseur;
     QPushButton *btnDetailsFournisseur;
@@ -220,6 +1747,7 @@ private:
     QLineEdit *searchFournisseurEdit;
     QComboBox *comboSortFournisseurs;
     QPushButton *btnExportPDF;
+    QPushButton *btnExportLot;
 
     // Fournisseurs - statistiques
     QLabel *labelTotalFournisseurs;
@@ -230,9 +1758,11 @@ private:
     PieChartWidget *chartFournisseurs;
 
     // Fournisseurs - performance
-    QTableWidget *tablePerformance;
+    QTableView *tablePerformance;
     QLabel *labelMeilleurFournisseur;
     QLabel *labelFournisseurRapide;
+    QTableWidget *tableClassementDelais;
+    QTableWidget *tableEncoursFournisseurs;
 
     // Fournisseurs - formulaire
     QLineEdit *editNomFournisseur;
@@ -288,7 +1818,7 @@ private:
     QWidget *pageDetailsClients;
 
     // CLIENTS - liste
-    QTableWidget *tableClients;
+    QTableView *tableClients;
     QPushButton *btnModifierClient;
     QPushButton *btnSupprimerClient;
     QPushButton *btnDetailsClient;
@@ -297,6 +1827,7 @@ private:
     QLineEdit *searchClientEdit;
     QComboBox *comboSortClients;
     QPushButton *btnExportPDFClient;
+    QPushButton *btnExportLotClient;
 
     // CLIENTS - statistiques
     QLabel *labelTotalClients;
@@ -307,9 +1838,12 @@ private:
     PieChartWidget *chartClients;
 
     // CLIENTS - performance
-    QTableWidget *tablePerformanceClients;
+    QTableView *tablePerformanceClients;
     QLabel *labelMeilleurClient;
     QLabel *labelClientRapide;
+    QComboBox *comboClassementClients;
+    QTableWidget *tableClassementClients;
+    QTableWidget *tableEncoursClients;
 
     // CLIENTS - formulaire
     QLineEdit *editNomClient;
@@ -357,7 +1891,7 @@ private:
     QWidget *pageListeStock;
     
     // Stock - liste
-    QTableWidget *tableProductions;
+    QTableView *tableProductions;
     QPushButton *btnModifierStock;
     QPushButton *btnSupprimerStock;
     QPushButton *btnDetailsStock;
@@ -371,6 +1905,24 @@ private:
     // Stock - statistiques
     PieChartWidget *pieChartWidgetStock;
     QWidget *pieChartContainerStock;
+
+    // Stock - cube de production (drill-down / roll-up)
+    QComboBox *comboCubeAxeStock;
+    QPushButton *btnCubeRemonterStock;
+    QLabel *labelCubeCheminStock;
+    QTableWidget *tableCubeStock;
+    ProductionCube::Slice cubeSlice;
+    QVector<QPair<ProductionCube::Slice, int>> cubeHistorique;
+    QVector<ProductionCube::Slice> cubeLignes;
+
+    // Stock - courbes de volumes
+    QComboBox *comboGranulariteStock;
+    LineChartWidget *lineChartWidgetStock;
+
+    // Stock - analyse des rendements
+    HistogramWidget *histogramRendementStock;
+    QTableWidget *tableRendementsStock;
+    QTableWidget *tableLotsAtypiquesStock;
     
     // Stock - formulaire
     QLineEdit *editIdentifiantStock;
@@ -386,6 +1938,15 @@ private:
     QPushButton *btnCalculerRendementStock;
     QLabel *labelQuantiteProduiteStock;
     
+    // Ventes - tableau de bord
+    QLabel *labelVentesCA;
+    QLabel *labelVentesMarge;
+    QLabel *labelVentesEncaisse;
+    QLabel *labelVentesReste;
+    LineChartWidget *chartVentesJour;
+    QTableWidget *tableTopProduits;
+    QPushButton *btnRetourMenuVentes;
+
     // Stock - splitter
     QSplitter *mainSplitterStock;
     QSplitter *rightSplitterStock;